@@ -0,0 +1,599 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "BarrettReducer.hpp"
+#include "BigInt.hpp"
+#include "BigRational.hpp"
+#include "BigUint.hpp"
+#include "MontgomeryContext.hpp"
+#include "limbs.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+using Operation = std::function<void()>;
+
+constexpr size_t BATCHES = 5;
+constexpr size_t FULL_SWEEP = 1'000'000;
+// Operations that are superlinear beyond a multiplication stop here, so that a full sweep finishes in minutes.
+constexpr size_t GCD_LIMIT = 100'000;
+constexpr size_t POW_MOD_LIMIT = 100;
+
+struct Benchmark final
+{
+    std::string name;
+    size_t max_limbs;
+    // Builds the operands for the given size and returns the operation to time.
+    std::function<Operation(size_t limbs, std::mt19937_64& rng)> setup;
+};
+
+struct Result final
+{
+    std::string name;
+    size_t limbs;
+    size_t iterations;
+    double median_ns;
+    double min_ns;
+};
+
+struct Options final
+{
+    size_t min_limbs = 1;
+    size_t max_limbs = FULL_SWEEP;
+    double min_time = 0.1;
+    std::string filter;
+    std::string format = "csv";
+    std::string output;
+    std::string baseline;
+    double threshold = 0.1;
+    bool list = false;
+};
+
+// Keeps the optimizer from discarding results that are never read.
+volatile size_t sink = 0;
+
+template <typename T>
+void consume(const T& value)
+{
+    sink = sink + value.is_zero();
+}
+
+BigUint random_uint(const size_t limbs, std::mt19937_64& rng)
+{
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    std::string hex(16 * limbs, '0');
+    for (char& digit : hex)
+    {
+        digit = DIGITS[rng() & 15];
+    }
+    hex[0] = DIGITS[8 + (rng() & 7)];
+    return BigUint::from_string(hex, BigUint::Base::HEXADECIMAL);
+}
+
+BigUint random_odd(const size_t limbs, std::mt19937_64& rng)
+{
+    BigUint res = random_uint(limbs, rng);
+    if (res % 2 == 0)
+    {
+        res += 1;
+    }
+    return res;
+}
+
+BigInt random_int(const size_t limbs, std::mt19937_64& rng)
+{
+    return BigInt(random_uint(limbs, rng), (rng() & 1) != 0);
+}
+
+BigRational random_rational(const size_t limbs, std::mt19937_64& rng)
+{
+    return BigRational(random_int(limbs, rng), random_uint(limbs, rng));
+}
+
+// A binary operation on two fresh n-limb operands whose result is consumed.
+template <typename T, typename Make, typename Apply>
+Benchmark binary(std::string name, const size_t max_limbs, Make make, Apply apply)
+{
+    return {std::move(name), max_limbs,
+            [make, apply](const size_t limbs, std::mt19937_64& rng) -> Operation
+            {
+                auto a = std::make_shared<T>(make(limbs, rng));
+                auto b = std::make_shared<T>(make(limbs, rng));
+                return [a, b, apply] { consume(apply(*a, *b)); };
+            }};
+}
+
+template <typename T, typename Make, typename Apply>
+Benchmark unary(std::string name, const size_t max_limbs, Make make, Apply apply)
+{
+    return {std::move(name), max_limbs,
+            [make, apply](const size_t limbs, std::mt19937_64& rng) -> Operation
+            {
+                auto a = std::make_shared<T>(make(limbs, rng));
+                return [a, apply] { apply(*a); };
+            }};
+}
+
+struct Flag final
+{
+    bool value;
+
+    bool is_zero() const { return !value; }
+};
+
+std::vector<Benchmark> benchmarks()
+{
+    std::vector<Benchmark> res;
+
+    res.push_back(binary<BigUint>("uint_add", FULL_SWEEP, random_uint, std::plus<>()));
+    res.push_back(binary<BigUint>("uint_sub", FULL_SWEEP, random_uint,
+                                  [](const BigUint& a, const BigUint& b) { return a < b ? b - a : a - b; }));
+    res.push_back(binary<BigUint>("uint_mul", FULL_SWEEP, random_uint, std::multiplies<>()));
+    res.push_back(unary<BigUint>("uint_square", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { consume(a.square()); }));
+    res.push_back(unary<BigUint>("uint_mul_limb", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { consume(a * 0x9e3779b97f4a7c15ULL); }));
+    res.push_back({"uint_div", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto num = std::make_shared<BigUint>(random_uint(2 * limbs, rng));
+                       auto den = std::make_shared<BigUint>(random_uint(limbs, rng));
+                       return [num, den] { consume(*num / *den); };
+                   }});
+    res.push_back({"uint_mod", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto num = std::make_shared<BigUint>(random_uint(2 * limbs, rng));
+                       auto den = std::make_shared<BigUint>(random_uint(limbs, rng));
+                       return [num, den] { consume(*num % *den); };
+                   }});
+    res.push_back(unary<BigUint>("uint_div_limb", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { consume(a / 0x9e3779b97f4a7c15ULL); }));
+    res.push_back(unary<BigUint>("uint_mod_limb", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { sink = sink + a % 0x9e3779b97f4a7c15ULL; }));
+    res.push_back(unary<BigUint>("uint_shift_left", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { consume(a << 77); }));
+    res.push_back(unary<BigUint>("uint_shift_right", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { consume(a >> 77); }));
+    res.push_back(binary<BigUint>("uint_compare", FULL_SWEEP, random_uint,
+                                  [](const BigUint& a, const BigUint& b) { return Flag{a < b}; }));
+    res.push_back(unary<BigUint>("uint_bit_width", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { sink = sink + a.bit_width(); }));
+    res.push_back(binary<BigUint>("uint_gcd", GCD_LIMIT, random_uint,
+                                  [](const BigUint& a, const BigUint& b) { return a.gcd(b); }));
+    res.push_back(binary<BigUint>("uint_lcm", GCD_LIMIT, random_uint,
+                                  [](const BigUint& a, const BigUint& b) { return a.lcm(b); }));
+    res.push_back(unary<BigUint>("uint_pow3", FULL_SWEEP, random_uint, [](const BigUint& a) { consume(a.pow(3)); }));
+    res.push_back(unary<BigUint>("uint_isqrt", FULL_SWEEP, random_uint, [](const BigUint& a) { consume(a.isqrt()); }));
+    res.push_back(unary<BigUint>("uint_iroot3", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { consume(a.iroot(3)); }));
+    res.push_back(unary<BigUint>(
+        "uint_is_perfect_square", FULL_SWEEP,
+        [](const size_t limbs, std::mt19937_64& rng) { return random_uint((limbs + 1) / 2, rng).square(); },
+        [](const BigUint& a) { consume(Flag{a.is_perfect_square()}); }));
+    res.push_back({"uint_pow_mod_odd", POW_MOD_LIMIT,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto base = std::make_shared<BigUint>(random_uint(limbs, rng));
+                       auto exp = std::make_shared<BigUint>(random_uint(limbs, rng));
+                       auto mod = std::make_shared<BigUint>(random_odd(limbs, rng));
+                       return [base, exp, mod] { consume(BigUint::pow_mod(*base, *exp, *mod)); };
+                   }});
+    res.push_back({"uint_pow_mod_even", POW_MOD_LIMIT,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto base = std::make_shared<BigUint>(random_uint(limbs, rng));
+                       auto exp = std::make_shared<BigUint>(random_uint(limbs, rng));
+                       auto mod = std::make_shared<BigUint>(random_odd(limbs, rng) + 1);
+                       return [base, exp, mod] { consume(BigUint::pow_mod(*base, *exp, *mod)); };
+                   }});
+    res.push_back({"montgomery_multiply", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto context = std::make_shared<MontgomeryContext>(random_odd(limbs, rng));
+                       auto a = std::make_shared<BigUint>(context->to_montgomery(random_uint(limbs, rng)));
+                       auto b = std::make_shared<BigUint>(context->to_montgomery(random_uint(limbs, rng)));
+                       return [context, a, b] { consume(context->multiply(*a, *b)); };
+                   }});
+    res.push_back({"barrett_mulmod", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto reducer = std::make_shared<BarrettReducer>(random_uint(limbs, rng));
+                       auto a = std::make_shared<BigUint>(reducer->reduce(random_uint(limbs, rng)));
+                       auto b = std::make_shared<BigUint>(reducer->reduce(random_uint(limbs, rng)));
+                       return [reducer, a, b] { consume(reducer->mulmod(*a, *b)); };
+                   }});
+    res.push_back(unary<BigUint>("uint_to_string_dec", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { sink = sink + a.to_string(BigUint::Base::DECIMAL).size(); }));
+    res.push_back(unary<BigUint>("uint_to_string_hex", FULL_SWEEP, random_uint,
+                                 [](const BigUint& a) { sink = sink + a.to_string().size(); }));
+    res.push_back({"uint_from_string_dec", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto str =
+                           std::make_shared<std::string>(random_uint(limbs, rng).to_string(BigUint::Base::DECIMAL));
+                       return [str] { consume(BigUint::from_string(*str, BigUint::Base::DECIMAL)); };
+                   }});
+    res.push_back({"uint_from_string_hex", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto str = std::make_shared<std::string>(random_uint(limbs, rng).to_string());
+                       return [str] { consume(BigUint::from_string(*str)); };
+                   }});
+
+    res.push_back(binary<BigInt>("int_add", FULL_SWEEP, random_int, std::plus<>()));
+    res.push_back(binary<BigInt>("int_sub", FULL_SWEEP, random_int, std::minus<>()));
+    res.push_back(binary<BigInt>("int_mul", FULL_SWEEP, random_int, std::multiplies<>()));
+    res.push_back(unary<BigInt>("int_square", FULL_SWEEP, random_int, [](const BigInt& a) { consume(a.square()); }));
+    res.push_back({"int_div", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto num = std::make_shared<BigInt>(random_int(2 * limbs, rng));
+                       auto den = std::make_shared<BigInt>(random_int(limbs, rng));
+                       return [num, den] { consume(*num / *den); };
+                   }});
+    res.push_back({"int_mod", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto num = std::make_shared<BigInt>(random_int(2 * limbs, rng));
+                       auto den = std::make_shared<BigInt>(random_int(limbs, rng));
+                       return [num, den] { consume(*num % *den); };
+                   }});
+    res.push_back(binary<BigInt>("int_compare", FULL_SWEEP, random_int,
+                                 [](const BigInt& a, const BigInt& b) { return Flag{a < b}; }));
+    res.push_back(binary<BigInt>("int_gcd", GCD_LIMIT, random_int,
+                                 [](const BigInt& a, const BigInt& b) { return a.gcd(b); }));
+    res.push_back(binary<BigInt>("int_gcdext", GCD_LIMIT, random_int,
+                                 [](const BigInt& a, const BigInt& b) { return std::get<0>(a.gcdext(b)); }));
+    res.push_back({"int_mod_inverse", GCD_LIMIT,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       BigInt mod(random_odd(limbs, rng));
+                       BigInt value = random_int(limbs, rng);
+                       while (!(value.gcd(mod) == BigInt(1)))
+                       {
+                           value += 1;
+                       }
+                       auto a = std::make_shared<BigInt>(std::move(value));
+                       auto m = std::make_shared<BigInt>(std::move(mod));
+                       return [a, m] { consume(a->mod_inverse(*m)); };
+                   }});
+    res.push_back({"int_pow_mod", POW_MOD_LIMIT,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto base = std::make_shared<BigInt>(random_int(limbs, rng));
+                       auto exp = std::make_shared<BigInt>(random_uint(limbs, rng));
+                       auto mod = std::make_shared<BigInt>(random_odd(limbs, rng));
+                       return [base, exp, mod] { consume(BigInt::pow_mod(*base, *exp, *mod)); };
+                   }});
+    res.push_back(unary<BigInt>("int_to_string_dec", FULL_SWEEP, random_int,
+                                [](const BigInt& a) { sink = sink + a.to_string(BigUint::Base::DECIMAL).size(); }));
+    res.push_back({"int_from_string_dec", FULL_SWEEP,
+                   [](const size_t limbs, std::mt19937_64& rng) -> Operation
+                   {
+                       auto str =
+                           std::make_shared<std::string>(random_int(limbs, rng).to_string(BigUint::Base::DECIMAL));
+                       return [str] { consume(BigInt::from_string(*str, BigUint::Base::DECIMAL)); };
+                   }});
+
+    res.push_back(binary<BigRational>("rational_add", GCD_LIMIT, random_rational, std::plus<>()));
+    res.push_back(binary<BigRational>("rational_sub", GCD_LIMIT, random_rational, std::minus<>()));
+    res.push_back(binary<BigRational>("rational_mul", GCD_LIMIT, random_rational, std::multiplies<>()));
+    res.push_back(binary<BigRational>("rational_div", GCD_LIMIT, random_rational, std::divides<>()));
+    res.push_back(binary<BigRational>("rational_compare", GCD_LIMIT, random_rational,
+                                      [](const BigRational& a, const BigRational& b) { return Flag{a < b}; }));
+    res.push_back(unary<BigRational>("rational_minimize", GCD_LIMIT, random_rational,
+                                     [](const BigRational& a)
+                                     {
+                                         BigRational copy = a;
+                                         copy.minimize();
+                                         consume(copy);
+                                     }));
+    return res;
+}
+
+// 1, 2, 5, 10, 20, 50, ... within the requested range.
+std::vector<size_t> sweep_sizes(const Options& options)
+{
+    std::vector<size_t> res;
+    for (size_t decade = 1; decade <= options.max_limbs; decade *= 10)
+    {
+        for (const size_t step : {1, 2, 5})
+        {
+            const size_t size = decade * step;
+            if (size >= options.min_limbs && size <= options.max_limbs)
+            {
+                res.push_back(size);
+            }
+        }
+    }
+    return res;
+}
+
+double elapsed_ns(const Operation& operation, const size_t iterations)
+{
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        operation();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Grows the iteration count until a batch takes a fifth of the time budget, then times BATCHES batches.
+Result measure(const std::string& name, const size_t limbs, const Operation& operation, const double min_time)
+{
+    const double batch_ns = min_time * 1e9 / BATCHES;
+    size_t iterations = 1;
+    double ns = elapsed_ns(operation, iterations);
+    while (ns < batch_ns)
+    {
+        iterations = ns <= 0 ? iterations * 10
+                             : std::max(iterations + 1, static_cast<size_t>(iterations * batch_ns / ns));
+        ns = elapsed_ns(operation, iterations);
+    }
+
+    std::vector<double> per_op;
+    for (size_t batch = 0; batch < BATCHES; ++batch)
+    {
+        per_op.push_back(elapsed_ns(operation, iterations) / static_cast<double>(iterations));
+    }
+    std::sort(per_op.begin(), per_op.end());
+    return {name, limbs, iterations, per_op[BATCHES / 2], per_op.front()};
+}
+
+void write_csv(std::ostream& stream, const std::vector<Result>& results)
+{
+    stream << "op,limbs,iterations,median_ns,min_ns\n";
+    for (const Result& result : results)
+    {
+        stream << result.name << ',' << result.limbs << ',' << result.iterations << ',' << result.median_ns << ','
+               << result.min_ns << '\n';
+    }
+}
+
+// One result per line, which is also what read_results expects.
+void write_json(std::ostream& stream, const std::vector<Result>& results)
+{
+    stream << "{\n  \"kernel\": \"" << limbs::kernel_name(limbs::kernel()) << "\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        stream << "    {\"op\": \"" << result.name << "\", \"limbs\": " << result.limbs
+               << ", \"iterations\": " << result.iterations << ", \"median_ns\": " << result.median_ns
+               << ", \"min_ns\": " << result.min_ns << '}' << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    stream << "  ]\n}\n";
+}
+
+std::string json_field(const std::string& line, const std::string& key)
+{
+    const size_t key_position = line.find('"' + key + "\":");
+    if (key_position == std::string::npos)
+    {
+        return {};
+    }
+    size_t begin = line.find_first_not_of(" \"", key_position + key.size() + 3);
+    const size_t end = line.find_first_of(",}\"", begin);
+    return line.substr(begin, end - begin);
+}
+
+// Reads a file written by write_csv or write_json.
+std::map<std::pair<std::string, size_t>, double> read_results(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open baseline " + path);
+    }
+
+    std::map<std::pair<std::string, size_t>, double> res;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.find("\"op\":") != std::string::npos)
+        {
+            res[{json_field(line, "op"), std::stoull(json_field(line, "limbs"))}] =
+                std::stod(json_field(line, "median_ns"));
+            continue;
+        }
+
+        std::stringstream fields(line);
+        std::string name, limbs, iterations, median;
+        if (std::getline(fields, name, ',') && std::getline(fields, limbs, ',') &&
+            std::getline(fields, iterations, ',') && std::getline(fields, median, ',') && name != "op")
+        {
+            res[{name, std::stoull(limbs)}] = std::stod(median);
+        }
+    }
+    return res;
+}
+
+// Prints every entry that moved by more than the threshold and returns the number of regressions.
+size_t compare(const std::vector<Result>& results, const std::string& baseline_path, const double threshold)
+{
+    const auto baseline = read_results(baseline_path);
+    size_t regressions = 0;
+    size_t improvements = 0;
+    for (const Result& result : results)
+    {
+        const auto iter = baseline.find({result.name, result.limbs});
+        if (iter == baseline.end() || iter->second <= 0)
+        {
+            continue;
+        }
+
+        const double ratio = result.median_ns / iter->second;
+        if (ratio > 1 + threshold)
+        {
+            ++regressions;
+            std::fprintf(stderr, "REGRESSION  %-24s %8zu limbs  %12.1f -> %12.1f ns  (%+.1f%%)\n", result.name.c_str(),
+                         result.limbs, iter->second, result.median_ns, (ratio - 1) * 100);
+        }
+        else if (ratio < 1 - threshold)
+        {
+            ++improvements;
+            std::fprintf(stderr, "improvement %-24s %8zu limbs  %12.1f -> %12.1f ns  (%+.1f%%)\n", result.name.c_str(),
+                         result.limbs, iter->second, result.median_ns, (ratio - 1) * 100);
+        }
+    }
+    std::fprintf(stderr, "%zu regressions, %zu improvements beyond %.0f%%\n", regressions, improvements,
+                 threshold * 100);
+    return regressions;
+}
+
+void usage()
+{
+    std::cerr << "usage: bigint_bench [options]\n"
+                 "  --min-limbs N       smallest operand size (default 1)\n"
+                 "  --max-limbs N       largest operand size (default 1000000)\n"
+                 "  --min-time S        seconds spent per operation and size (default 0.1)\n"
+                 "  --filter TEXT       only operations whose name contains TEXT\n"
+                 "  --format csv|json   output format (default csv)\n"
+                 "  --output PATH       write the results to PATH instead of stdout\n"
+                 "  --baseline PATH     compare against a saved run; exits with 1 on regressions\n"
+                 "  --threshold F       relative change treated as noise (default 0.1)\n"
+                 "  --list              print the operation names and exit\n";
+}
+
+Options parse_options(const int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        const auto value = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+            {
+                usage();
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--min-limbs")
+        {
+            options.min_limbs = std::stoull(value());
+        }
+        else if (arg == "--max-limbs")
+        {
+            options.max_limbs = std::stoull(value());
+        }
+        else if (arg == "--min-time")
+        {
+            options.min_time = std::stod(value());
+        }
+        else if (arg == "--filter")
+        {
+            options.filter = value();
+        }
+        else if (arg == "--format")
+        {
+            options.format = value();
+        }
+        else if (arg == "--output")
+        {
+            options.output = value();
+        }
+        else if (arg == "--baseline")
+        {
+            options.baseline = value();
+        }
+        else if (arg == "--threshold")
+        {
+            options.threshold = std::stod(value());
+        }
+        else if (arg == "--list")
+        {
+            options.list = true;
+        }
+        else
+        {
+            usage();
+            std::exit(arg == "--help" ? 0 : 2);
+        }
+    }
+
+    if (options.format != "csv" && options.format != "json")
+    {
+        usage();
+        std::exit(2);
+    }
+    return options;
+}
+} // namespace
+
+int main(const int argc, char** argv)
+{
+    const Options options = parse_options(argc, argv);
+    const std::vector<Benchmark> all = benchmarks();
+    if (options.list)
+    {
+        for (const Benchmark& benchmark : all)
+        {
+            std::cout << benchmark.name << '\n';
+        }
+        return 0;
+    }
+
+    std::mt19937_64 rng(0x5eed);
+    std::vector<Result> results;
+    for (const Benchmark& benchmark : all)
+    {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        for (const size_t limbs : sweep_sizes(options))
+        {
+            if (limbs > benchmark.max_limbs)
+            {
+                break;
+            }
+
+            const Operation operation = benchmark.setup(limbs, rng);
+            results.push_back(measure(benchmark.name, limbs, operation, options.min_time));
+            std::fprintf(stderr, "%-24s %8zu limbs  %14.1f ns\n", benchmark.name.c_str(), limbs,
+                         results.back().median_ns);
+        }
+    }
+
+    std::ofstream file;
+    if (!options.output.empty())
+    {
+        file.open(options.output);
+    }
+    std::ostream& stream = options.output.empty() ? std::cout : file;
+    stream.precision(10);
+    if (options.format == "json")
+    {
+        write_json(stream, results);
+    }
+    else
+    {
+        write_csv(stream, results);
+    }
+
+    if (!options.baseline.empty() && compare(results, options.baseline, options.threshold) != 0)
+    {
+        return 1;
+    }
+    return 0;
+}
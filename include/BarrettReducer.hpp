@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BigUint.hpp"
+#include "LimbVector.hpp"
+
+// Reduction by a fixed modulus of any parity with its reciprocal precomputed once: a value below m B^n (n the limb
+// count of m, so any product of two reduced values) is reduced with two multiplications and at most two subtractions.
+// Larger values fall back to a division.
+class BarrettReducer final
+{
+public:
+    explicit BarrettReducer(BigUint modulus);
+
+public:
+    BigUint reduce(const BigUint& number) const;
+    BigUint mulmod(const BigUint& a, const BigUint& b) const;
+    BigUint addmod(const BigUint& a, const BigUint& b) const;
+    constexpr const BigUint& modulus() const { return _modulus; }
+
+private:
+    size_t limb_count() const { return _modulus._number.size(); }
+    bool reduce_limbs(BigUint& res, const uint64_t* number, size_t number_size) const;
+
+private:
+    BigUint _modulus;
+    uint32_t _shift;
+    LimbVector _normalized;
+    LimbVector _reciprocal;
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <tuple>
 #include "BigUint.hpp"
 
 class BigInt final
@@ -18,17 +19,35 @@ public:
     BigInt& operator/=(const BigInt& other) &;
     BigInt& operator/=(const BigUint& other) &;
     BigInt& operator%=(const BigInt& other) &;
-    BigInt operator+(const BigInt& other) const;
-    BigInt operator-(const BigInt& other) const;
-    BigInt operator-() const;
-    BigInt operator>>(size_t bits) const;
-    BigInt operator<<(size_t bits) const;
-    BigInt operator*(const BigInt& other) const;
-    BigInt operator*(const BigUint& other) const;
-    BigInt operator*(uint64_t number) const;
-    BigInt operator/(const BigInt& other) const;
-    BigInt operator/(const BigUint& other) const;
-    BigInt operator%(const BigInt& other) const;
+    BigInt operator+(const BigInt& other) const&;
+    BigInt operator-(const BigInt& other) const&;
+    BigInt operator-() const&;
+    BigInt operator>>(size_t bits) const&;
+    BigInt operator<<(size_t bits) const&;
+    BigInt operator*(const BigInt& other) const&;
+    BigInt operator*(const BigUint& other) const&;
+    BigInt operator*(uint64_t number) const&;
+    BigInt operator/(const BigInt& other) const&;
+    BigInt operator/(const BigUint& other) const&;
+    BigInt operator%(const BigInt& other) const&;
+    BigInt operator+(const BigInt& other) &&;
+    BigInt operator-(const BigInt& other) &&;
+    BigInt operator-() &&;
+    BigInt operator>>(size_t bits) &&;
+    BigInt operator<<(size_t bits) &&;
+    BigInt operator*(const BigInt& other) &&;
+    BigInt operator*(const BigUint& other) &&;
+    BigInt operator*(uint64_t number) &&;
+    BigInt operator/(const BigInt& other) &&;
+    BigInt operator/(const BigUint& other) &&;
+    BigInt operator%(const BigInt& other) &&;
+
+public:
+    // Same contract as the BigUint forms. divmod truncates toward zero, so the remainder takes the sign of a.
+    static void add(BigInt& dest, const BigInt& a, const BigInt& b);
+    static void sub(BigInt& dest, const BigInt& a, const BigInt& b);
+    static void mul(BigInt& dest, const BigInt& a, const BigInt& b);
+    static void divmod(BigInt& quotient, BigInt& remainder, const BigInt& a, const BigInt& b);
 
 public:
     bool is_zero() const;
@@ -37,6 +56,14 @@ public:
     std::pair<BigInt, BigInt> div_and_mod(const BigInt& other) const;
     BigInt gcd(const BigInt& other) const;
     BigInt lcm(const BigInt& other) const;
+    BigInt square() const;
+    BigInt pow(uint64_t exponent) const;
+    // (gcd, x, y) with x * this + y * other = gcd and gcd >= 0.
+    std::tuple<BigInt, BigInt, BigInt> gcdext(const BigInt& other) const;
+    // The inverse in [0, |modulus|); throws std::invalid_argument if there is none.
+    BigInt mod_inverse(const BigInt& modulus) const;
+    // base^exp mod |mod| in [0, |mod|); a negative exponent raises the inverse of base.
+    static BigInt pow_mod(const BigInt& base, const BigInt& exp, const BigInt& mod);
     constexpr const BigUint& abs() const& { return _number; }
     constexpr bool is_neg() const { return _is_negative; }
     bool operator==(const BigInt& other) const;
@@ -46,6 +73,10 @@ public:
     bool operator>=(const BigInt& other) const { return other <= *this; }
 
 public:
+    std::string to_string(BigUint::Base base = BigUint::Base::HEXADECIMAL) const;
+    static BigInt from_string(std::string_view str, BigUint::Base base = BigUint::Base::HEXADECIMAL);
+    static std::from_chars_result from_chars(const char* first, const char* last, BigInt& value,
+                                             BigUint::Base base = BigUint::Base::HEXADECIMAL);
     friend std::basic_istream<char>& operator>>(std::basic_istream<char>& stream, BigInt& num);
     friend std::basic_ostream<char>& operator<<(std::basic_ostream<char>& stream, const BigInt& num);
 
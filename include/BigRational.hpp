@@ -1,10 +1,29 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include "BigInt.hpp"
 #include "BigUint.hpp"
 
 class BigRational final
 {
+public:
+    // How the arithmetic keeps numerator and denominator small. ALWAYS divides the common factors out of every result
+    // through the cross-gcd forms, so values stay in lowest terms. LAZY runs the plain formulas and reduces once the
+    // combined bit width grew by growth_bits since the last reduction. NEVER leaves it to minimize().
+    struct Normalization final
+    {
+        enum class Mode : uint8_t
+        {
+            ALWAYS,
+            LAZY,
+            NEVER,
+        };
+
+        Mode mode = Mode::ALWAYS;
+        size_t growth_bits = 1024;
+    };
+
 public:
     BigRational();
     BigRational(int64_t numerator);
@@ -18,16 +37,25 @@ public:
     BigRational& operator*=(uint64_t number) &;
     BigRational& operator/=(const BigRational& other) &;
     BigRational& operator/=(uint64_t number) &;
-    BigRational operator+(const BigRational& other) const;
-    BigRational operator-(const BigRational& other) const;
-    BigRational operator*(const BigRational& other) const;
-    BigRational operator*(uint64_t number) const;
-    BigRational operator/(const BigRational& other) const;
-    BigRational operator/(uint64_t number) const;
+    BigRational operator+(const BigRational& other) const&;
+    BigRational operator-(const BigRational& other) const&;
+    BigRational operator*(const BigRational& other) const&;
+    BigRational operator*(uint64_t number) const&;
+    BigRational operator/(const BigRational& other) const&;
+    BigRational operator/(uint64_t number) const&;
+    BigRational operator+(const BigRational& other) &&;
+    BigRational operator-(const BigRational& other) &&;
+    BigRational operator*(const BigRational& other) &&;
+    BigRational operator*(uint64_t number) &&;
+    BigRational operator/(const BigRational& other) &&;
+    BigRational operator/(uint64_t number) &&;
 
 public:
     bool is_zero() const;
     bool raw_equal(const BigRational& other) const;
+    // -1, 0 or 1. Decided by the signs, then the bit widths, then the leading 63 bits of each operand, then a few
+    // continued-fraction steps; the two full cross products are only formed for values that agree past all of those.
+    int compare(const BigRational& other) const;
     bool operator==(const BigRational& other) const;
     bool operator<(const BigRational& other) const;
     bool operator<=(const BigRational& other) const;
@@ -41,7 +69,22 @@ public:
 public:
     void minimize();
 
+    // Process-wide; change it while no arithmetic is running. Values built under another mode are only brought to
+    // lowest terms by their next reduction.
+    static Normalization normalization();
+    static void set_normalization(const Normalization& policy);
+
+private:
+    void add(const BigRational& other, bool subtract);
+    void normalize();
+    void set_zero();
+    size_t bit_size() const;
+    static int compare_magnitudes(const BigUint& a, const BigUint& b, const BigUint& c, const BigUint& d);
+    static uint64_t leading_bits(const BigUint& number, size_t shift);
+
 private:
     BigInt _numerator;
     BigUint _denominator;
+    // bit_size() right after the last reduction, which LAZY measures growth against.
+    size_t _reduced_bits;
 };
\ No newline at end of file
@@ -1,9 +1,16 @@
 #pragma once
 
 #include <cfloat>
+#include <charconv>
 #include <cstdint>
 #include <istream>
+#include <string>
+#include <string_view>
 #include <vector>
+#include "LimbVector.hpp"
+
+template <size_t Bits>
+class FixedUint;
 
 class BigUint final
 {
@@ -17,6 +24,9 @@ public:
 
 public:
     BigUint(uint64_t num = 0);
+    // Copies the limbs of a FixedUint, such as a _big literal; defined in FixedUint.hpp.
+    template <size_t Bits>
+    BigUint(const FixedUint<Bits>& other);
 
 public:
     BigUint& operator+=(const BigUint& other) &;
@@ -27,14 +37,37 @@ public:
     BigUint& operator*=(uint64_t number) &;
     BigUint& operator/=(const BigUint& other) &;
     BigUint& operator%=(const BigUint& other) &;
-    BigUint operator+(const BigUint& other) const;
-    BigUint operator-(const BigUint& other) const;
-    BigUint operator>>(size_t bits) const;
-    BigUint operator<<(size_t bits) const;
-    BigUint operator*(const BigUint& other) const;
-    BigUint operator*(uint64_t number) const;
-    BigUint operator/(const BigUint& other) const;
-    BigUint operator%(const BigUint& other) const;
+    BigUint& operator/=(uint64_t number) &;
+    BigUint& operator%=(uint64_t number) &;
+    BigUint operator+(const BigUint& other) const&;
+    BigUint operator-(const BigUint& other) const&;
+    BigUint operator>>(size_t bits) const&;
+    BigUint operator<<(size_t bits) const&;
+    BigUint operator*(const BigUint& other) const&;
+    BigUint operator*(uint64_t number) const&;
+    BigUint operator/(const BigUint& other) const&;
+    BigUint operator%(const BigUint& other) const&;
+    BigUint operator/(uint64_t number) const&;
+    BigUint operator+(const BigUint& other) &&;
+    BigUint operator-(const BigUint& other) &&;
+    BigUint operator>>(size_t bits) &&;
+    BigUint operator<<(size_t bits) &&;
+    BigUint operator*(const BigUint& other) &&;
+    BigUint operator*(uint64_t number) &&;
+    BigUint operator/(const BigUint& other) &&;
+    BigUint operator%(const BigUint& other) &&;
+    BigUint operator/(uint64_t number) &&;
+    uint64_t operator%(uint64_t number) const&;
+    uint64_t operator%(uint64_t number) &&;
+
+public:
+    // Three-operand forms that write into an existing object and reuse its limb buffer. Any operand may alias the
+    // destination; divmod's quotient and remainder must be distinct objects.
+    static void add(BigUint& dest, const BigUint& a, const BigUint& b);
+    static void sub(BigUint& dest, const BigUint& a, const BigUint& b);
+    static void mul(BigUint& dest, const BigUint& a, const BigUint& b);
+    static void sqr(BigUint& dest, const BigUint& a);
+    static void divmod(BigUint& quotient, BigUint& remainder, const BigUint& a, const BigUint& b);
 
 public:
     bool is_zero() const;
@@ -43,8 +76,16 @@ public:
     size_t size() const;
     BigUint get_n_bits(size_t begin, size_t end_excluding) const;
     std::pair<BigUint, BigUint> div_and_mod(const BigUint& other) const;
+    std::pair<BigUint, uint64_t> div_and_mod(uint64_t number) const;
     BigUint gcd(const BigUint& other) const;
     BigUint lcm(const BigUint& other) const;
+    BigUint square() const;
+    BigUint pow(uint64_t exponent) const;
+    BigUint isqrt() const;
+    std::pair<BigUint, BigUint> isqrt_rem() const;
+    BigUint iroot(uint64_t k) const;
+    bool is_perfect_square() const;
+    static BigUint pow_mod(const BigUint& base, const BigUint& exp, const BigUint& mod);
     bool operator==(const BigUint& other) const;
     bool operator<(const BigUint& other) const;
     bool operator<=(const BigUint& other) const;
@@ -53,15 +94,32 @@ public:
 
 public:
     std::string to_string(Base base = Base::HEXADECIMAL) const;
+    static BigUint from_string(std::string_view str, Base base = Base::HEXADECIMAL);
+    static std::from_chars_result from_chars(const char* first, const char* last, BigUint& value,
+                                             Base base = Base::HEXADECIMAL);
     friend std::basic_istream<char>& operator>>(std::basic_istream<char>& stream, BigUint& num);
     friend std::basic_ostream<char>& operator<<(std::basic_ostream<char>& stream, const BigUint& num);
 
 private:
-    bool less_than_shifted(const BigUint& other, size_t shift_count);
+    friend class NttMultiplier;
+    friend class Gcd;
+    friend class MontgomeryContext;
+    friend class BarrettReducer;
+    friend class BigRational;
+    template <size_t N>
+    friend class BigUintBatch;
+    template <size_t Bits>
+    friend class FixedUint;
+
+private:
     void fix_size();
+    void append_decimal(std::string& res, const std::vector<BigUint>& powers, size_t level, size_t width) const;
+    void append_decimal_basecase(std::string& res, size_t width) const;
+    static BigUint from_bits(const char* first, const char* last, uint32_t bits_per_digit);
+    static BigUint from_decimal_chunks(const uint64_t* chunks, size_t count, const std::vector<BigUint>& powers);
 
 private:
-    std::vector<uint64_t> _number;
+    LimbVector _number;
 
 public:
     BigUint(const BigUint&) = default;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "BigUint.hpp"
+#include "LimbVector.hpp"
+#include "limbs.hpp"
+
+// A batch of independent N-limb numbers stored limb-major, so that one SIMD instruction touches the same limb of
+// several numbers. Arithmetic wraps modulo 2^(64 N) and reports each item's carry out separately; carry pointers may
+// be null and otherwise hold size() entries. Both operands of a binary operation hold the same number of items.
+template <size_t N>
+class BigUintBatch final
+{
+    static_assert(N > 0, "A batch needs at least one limb per number");
+
+public:
+    explicit BigUintBatch(const size_t count = 0) : _count(count), _limbs(N * count, 0) {}
+
+public:
+    size_t size() const { return _count; }
+    uint64_t* limb(const size_t index) { return _limbs.data() + index * _count; }
+    const uint64_t* limb(const size_t index) const { return _limbs.data() + index * _count; }
+
+    BigUint get(const size_t index) const
+    {
+        BigUint res;
+        res._number.resize_for_overwrite(N);
+        for (size_t j = 0; j < N; ++j)
+        {
+            res._number[j] = limb(j)[index];
+        }
+        res.fix_size();
+        return res;
+    }
+
+    void set(const size_t index, const BigUint& value)
+    {
+        const size_t size = value._number.size();
+        if (size > N)
+        {
+            throw std::overflow_error("BigUint does not fit the batch width");
+        }
+        for (size_t j = 0; j < N; ++j)
+        {
+            limb(j)[index] = j < size ? value._number[j] : 0;
+        }
+    }
+
+    // this[i] += other[i]
+    void add(const BigUintBatch& other, uint64_t* carries = nullptr)
+    {
+        limbs::batch_add(_limbs.data(), other._limbs.data(), N, _count, carries);
+    }
+
+    // this[i] -= other[i]
+    void sub(const BigUintBatch& other, uint64_t* borrows = nullptr)
+    {
+        limbs::batch_sub(_limbs.data(), other._limbs.data(), N, _count, borrows);
+    }
+
+    // this[i] *= factors[i]
+    void mul_limb(const uint64_t* factors, uint64_t* carries = nullptr)
+    {
+        limbs::batch_mul_1(_limbs.data(), _limbs.data(), N, _count, factors, carries);
+    }
+
+    // this[i] += a[i] * factors[i]
+    void addmul_limb(const BigUintBatch& a, const uint64_t* factors, uint64_t* carries = nullptr)
+    {
+        limbs::batch_addmul_1(_limbs.data(), a._limbs.data(), N, _count, factors, carries);
+    }
+
+    // res[i] is -1, 0 or 1 as this[i] is below, equal to or above other[i].
+    void compare(const BigUintBatch& other, int8_t* res) const
+    {
+        limbs::batch_cmp(_limbs.data(), other._limbs.data(), N, _count, res);
+    }
+
+private:
+    size_t _count;
+    LimbVector _limbs;
+};
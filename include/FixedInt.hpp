@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "BigInt.hpp"
+#include "FixedUint.hpp"
+
+// A signed integer of exactly Bits bits in two's complement over a FixedUint. Addition, subtraction and
+// multiplication wrap like the unsigned kernels they reuse; division and right shifts truncate toward zero like BigInt.
+template <size_t Bits>
+class FixedInt final
+{
+public:
+    constexpr FixedInt(const int64_t num = 0) : _value(static_cast<uint64_t>(num))
+    {
+        if (num < 0)
+        {
+            for (size_t i = 1; i < FixedUint<Bits>::LIMBS; ++i)
+            {
+                _value.set_limb(i, UINT64_MAX);
+            }
+        }
+    }
+
+    // Reinterprets the bits of an unsigned value.
+    constexpr explicit FixedInt(const FixedUint<Bits>& bits) : _value(bits) {}
+
+    // Throws std::overflow_error when the value is outside [-2^(Bits - 1), 2^(Bits - 1)).
+    explicit FixedInt(const BigInt& other) : _value(other.abs())
+    {
+        const size_t width = _value.bit_width();
+        if (width > Bits - 1 && !(other.is_neg() && width == Bits && (_value & (_value - 1)).is_zero()))
+        {
+            throw std::overflow_error("BigInt does not fit the FixedInt width");
+        }
+        if (other.is_neg())
+        {
+            _value = -_value;
+        }
+    }
+
+public:
+    constexpr FixedInt& operator+=(const FixedInt& other) &
+    {
+        _value += other._value;
+        return *this;
+    }
+
+    constexpr FixedInt& operator-=(const FixedInt& other) &
+    {
+        _value -= other._value;
+        return *this;
+    }
+
+    constexpr FixedInt& operator*=(const FixedInt& other) &
+    {
+        _value *= other._value;
+        return *this;
+    }
+
+    constexpr FixedInt& operator/=(const FixedInt& other) &
+    {
+        *this = div_and_mod(other).first;
+        return *this;
+    }
+
+    constexpr FixedInt& operator%=(const FixedInt& other) &
+    {
+        *this = div_and_mod(other).second;
+        return *this;
+    }
+
+    constexpr FixedInt& operator<<=(const size_t bits) &
+    {
+        _value <<= bits;
+        return *this;
+    }
+
+    // Shifts the magnitude, so negative values round toward zero as BigInt does, not toward negative infinity.
+    constexpr FixedInt& operator>>=(const size_t bits) &
+    {
+        if (!is_neg())
+        {
+            _value >>= bits;
+        }
+        else
+        {
+            _value = -(abs() >> bits);
+        }
+        return *this;
+    }
+
+    constexpr FixedInt operator+(const FixedInt& other) const
+    {
+        FixedInt res(*this);
+        return res += other;
+    }
+
+    constexpr FixedInt operator-(const FixedInt& other) const
+    {
+        FixedInt res(*this);
+        return res -= other;
+    }
+
+    constexpr FixedInt operator*(const FixedInt& other) const
+    {
+        FixedInt res(*this);
+        return res *= other;
+    }
+
+    constexpr FixedInt operator/(const FixedInt& other) const { return div_and_mod(other).first; }
+    constexpr FixedInt operator%(const FixedInt& other) const { return div_and_mod(other).second; }
+
+    constexpr FixedInt operator<<(const size_t bits) const
+    {
+        FixedInt res(*this);
+        return res <<= bits;
+    }
+
+    constexpr FixedInt operator>>(const size_t bits) const
+    {
+        FixedInt res(*this);
+        return res >>= bits;
+    }
+
+    constexpr FixedInt operator-() const { return FixedInt(-_value); }
+
+public:
+    constexpr bool is_zero() const { return _value.is_zero(); }
+    constexpr bool is_neg() const { return (_value.limb(FixedUint<Bits>::LIMBS - 1) >> 63) != 0; }
+    constexpr const FixedUint<Bits>& bits() const { return _value; }
+
+    // The magnitude, which is exact even for -2^(Bits - 1).
+    constexpr FixedUint<Bits> abs() const { return is_neg() ? -_value : _value; }
+
+    // The quotient truncates toward zero and the remainder takes the sign of the dividend.
+    constexpr std::pair<FixedInt, FixedInt> div_and_mod(const FixedInt& other) const
+    {
+        auto [quotient, remainder] = abs().div_and_mod(other.abs());
+        if (is_neg() != other.is_neg())
+        {
+            quotient = -quotient;
+        }
+        if (is_neg())
+        {
+            remainder = -remainder;
+        }
+        return {FixedInt(quotient), FixedInt(remainder)};
+    }
+
+    constexpr bool operator==(const FixedInt& other) const { return _value == other._value; }
+
+    constexpr bool operator<(const FixedInt& other) const
+    {
+        if (is_neg() != other.is_neg())
+        {
+            return is_neg();
+        }
+        return _value < other._value;
+    }
+
+    constexpr bool operator<=(const FixedInt& other) const { return !(other < *this); }
+    constexpr bool operator>(const FixedInt& other) const { return other < *this; }
+    constexpr bool operator>=(const FixedInt& other) const { return !(*this < other); }
+
+public:
+    BigInt to_big_int() const { return BigInt(abs().to_big_uint(), is_neg()); }
+
+    std::string to_string(const BigUint::Base base = BigUint::Base::HEXADECIMAL) const
+    {
+        return to_big_int().to_string(base);
+    }
+
+private:
+    FixedUint<Bits> _value;
+
+public:
+    constexpr FixedInt(const FixedInt&) = default;
+    constexpr FixedInt& operator=(const FixedInt&) = default;
+    constexpr FixedInt(FixedInt&&) noexcept = default;
+    constexpr FixedInt& operator=(FixedInt&&) noexcept = default;
+    constexpr ~FixedInt() = default;
+};
@@ -0,0 +1,568 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "BigUint.hpp"
+
+// An unsigned integer of exactly Bits bits with its limbs inline. Arithmetic wraps modulo 2^Bits like the built-in
+// unsigned types and never allocates; the linear kernels are unrolled over the limb count, so each width compiles to
+// straight-line code.
+template <size_t Bits>
+class FixedUint final
+{
+    static_assert(Bits > 0 && Bits % 64 == 0, "FixedUint width must be a positive multiple of 64 bits");
+
+public:
+    static constexpr size_t LIMBS = Bits / 64;
+
+public:
+    constexpr FixedUint(const uint64_t num = 0) : _limbs{num} {}
+
+    // Throws std::overflow_error when the value needs more than Bits bits.
+    explicit FixedUint(const BigUint& other) : _limbs{}
+    {
+        const size_t size = other._number.size();
+        if (size > LIMBS)
+        {
+            throw std::overflow_error("BigUint does not fit the FixedUint width");
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            _limbs[i] = other._number[i];
+        }
+    }
+
+    // Widens with zeros or truncates to the low Bits bits, like a cast between the built-in unsigned types.
+    template <size_t OtherBits>
+    constexpr explicit FixedUint(const FixedUint<OtherBits>& other) : _limbs{}
+    {
+        for (size_t i = 0; i < LIMBS && i < FixedUint<OtherBits>::LIMBS; ++i)
+        {
+            _limbs[i] = other._limbs[i];
+        }
+    }
+
+public:
+    constexpr FixedUint& operator+=(const FixedUint& other) &
+    {
+        uint64_t carry = 0;
+        unroll<LIMBS>(
+            [&](const size_t i)
+            {
+                const Uint128 sum = static_cast<Uint128>(_limbs[i]) + other._limbs[i] + carry;
+                _limbs[i] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            });
+        return *this;
+    }
+
+    constexpr FixedUint& operator-=(const FixedUint& other) &
+    {
+        uint64_t borrow = 0;
+        unroll<LIMBS>(
+            [&](const size_t i)
+            {
+                const Uint128 difference = static_cast<Uint128>(_limbs[i]) - other._limbs[i] - borrow;
+                _limbs[i] = static_cast<uint64_t>(difference);
+                borrow = static_cast<uint64_t>(difference >> 64) & 1;
+            });
+        return *this;
+    }
+
+    // The product truncated to Bits bits; only the limbs that land below the width are multiplied.
+    constexpr FixedUint& operator*=(const FixedUint& other) &
+    {
+        std::array<uint64_t, LIMBS> res{};
+        unroll<LIMBS>(
+            [&](const size_t i)
+            {
+                uint64_t carry = 0;
+                for (size_t j = 0; i + j < LIMBS; ++j)
+                {
+                    const Uint128 product = static_cast<Uint128>(_limbs[i]) * other._limbs[j] + res[i + j] + carry;
+                    res[i + j] = static_cast<uint64_t>(product);
+                    carry = static_cast<uint64_t>(product >> 64);
+                }
+            });
+        _limbs = res;
+        return *this;
+    }
+
+    constexpr FixedUint& operator/=(const FixedUint& other) &
+    {
+        *this = div_and_mod(other).first;
+        return *this;
+    }
+
+    constexpr FixedUint& operator%=(const FixedUint& other) &
+    {
+        *this = div_and_mod(other).second;
+        return *this;
+    }
+
+    constexpr FixedUint& operator<<=(const size_t bits) &
+    {
+        const size_t limb_shift = bits / 64;
+        const uint32_t bit_shift = bits % 64;
+        for (size_t i = LIMBS; i-- > 0;)
+        {
+            uint64_t value = 0;
+            if (i >= limb_shift)
+            {
+                value = _limbs[i - limb_shift] << bit_shift;
+                if (bit_shift != 0 && i > limb_shift)
+                {
+                    value |= _limbs[i - limb_shift - 1] >> (64 - bit_shift);
+                }
+            }
+            _limbs[i] = value;
+        }
+        return *this;
+    }
+
+    constexpr FixedUint& operator>>=(const size_t bits) &
+    {
+        const size_t limb_shift = bits / 64;
+        const uint32_t bit_shift = bits % 64;
+        for (size_t i = 0; i < LIMBS; ++i)
+        {
+            uint64_t value = 0;
+            if (i + limb_shift < LIMBS)
+            {
+                value = _limbs[i + limb_shift] >> bit_shift;
+                if (bit_shift != 0 && i + limb_shift + 1 < LIMBS)
+                {
+                    value |= _limbs[i + limb_shift + 1] << (64 - bit_shift);
+                }
+            }
+            _limbs[i] = value;
+        }
+        return *this;
+    }
+
+    constexpr FixedUint& operator&=(const FixedUint& other) &
+    {
+        unroll<LIMBS>([&](const size_t i) { _limbs[i] &= other._limbs[i]; });
+        return *this;
+    }
+
+    constexpr FixedUint& operator|=(const FixedUint& other) &
+    {
+        unroll<LIMBS>([&](const size_t i) { _limbs[i] |= other._limbs[i]; });
+        return *this;
+    }
+
+    constexpr FixedUint& operator^=(const FixedUint& other) &
+    {
+        unroll<LIMBS>([&](const size_t i) { _limbs[i] ^= other._limbs[i]; });
+        return *this;
+    }
+
+    constexpr FixedUint operator+(const FixedUint& other) const
+    {
+        FixedUint res(*this);
+        return res += other;
+    }
+
+    constexpr FixedUint operator-(const FixedUint& other) const
+    {
+        FixedUint res(*this);
+        return res -= other;
+    }
+
+    constexpr FixedUint operator*(const FixedUint& other) const
+    {
+        FixedUint res(*this);
+        return res *= other;
+    }
+
+    constexpr FixedUint operator/(const FixedUint& other) const { return div_and_mod(other).first; }
+    constexpr FixedUint operator%(const FixedUint& other) const { return div_and_mod(other).second; }
+
+    constexpr FixedUint operator<<(const size_t bits) const
+    {
+        FixedUint res(*this);
+        return res <<= bits;
+    }
+
+    constexpr FixedUint operator>>(const size_t bits) const
+    {
+        FixedUint res(*this);
+        return res >>= bits;
+    }
+
+    constexpr FixedUint operator&(const FixedUint& other) const
+    {
+        FixedUint res(*this);
+        return res &= other;
+    }
+
+    constexpr FixedUint operator|(const FixedUint& other) const
+    {
+        FixedUint res(*this);
+        return res |= other;
+    }
+
+    constexpr FixedUint operator^(const FixedUint& other) const
+    {
+        FixedUint res(*this);
+        return res ^= other;
+    }
+
+    constexpr FixedUint operator~() const
+    {
+        FixedUint res;
+        unroll<LIMBS>([&](const size_t i) { res._limbs[i] = ~_limbs[i]; });
+        return res;
+    }
+
+    constexpr FixedUint operator-() const { return ~*this + FixedUint(1); }
+
+public:
+    constexpr bool is_zero() const
+    {
+        uint64_t any = 0;
+        unroll<LIMBS>([&](const size_t i) { any |= _limbs[i]; });
+        return any == 0;
+    }
+
+    constexpr size_t bit_width() const
+    {
+        for (size_t i = LIMBS; i-- > 0;)
+        {
+            if (_limbs[i] != 0)
+            {
+                return 64 * i + std::bit_width(_limbs[i]);
+            }
+        }
+        return 0;
+    }
+
+    constexpr uint64_t limb(const size_t index) const { return _limbs[index]; }
+    constexpr void set_limb(const size_t index, const uint64_t value) { _limbs[index] = value; }
+
+    // The full 2 Bits-bit product.
+    constexpr FixedUint<2 * Bits> mul_wide(const FixedUint& other) const
+    {
+        FixedUint<2 * Bits> res;
+        unroll<LIMBS>(
+            [&](const size_t i)
+            {
+                uint64_t carry = 0;
+                for (size_t j = 0; j < LIMBS; ++j)
+                {
+                    const Uint128 product =
+                        static_cast<Uint128>(_limbs[i]) * other._limbs[j] + res._limbs[i + j] + carry;
+                    res._limbs[i + j] = static_cast<uint64_t>(product);
+                    carry = static_cast<uint64_t>(product >> 64);
+                }
+                res._limbs[i + LIMBS] = carry;
+            });
+        return res;
+    }
+
+    // Knuth's algorithm D on the inline limbs; throws std::invalid_argument for a zero divisor.
+    constexpr std::pair<FixedUint, FixedUint> div_and_mod(const FixedUint& other) const
+    {
+        size_t den_size = LIMBS;
+        while (den_size > 0 && other._limbs[den_size - 1] == 0)
+        {
+            --den_size;
+        }
+        if (den_size == 0)
+        {
+            throw std::invalid_argument("Division by zero is undefined");
+        }
+
+        FixedUint quotient;
+        if (den_size == 1)
+        {
+            const uint64_t den = other._limbs[0];
+            Uint128 remainder = 0;
+            for (size_t i = LIMBS; i-- > 0;)
+            {
+                const Uint128 value = (remainder << 64) | _limbs[i];
+                quotient._limbs[i] = static_cast<uint64_t>(value / den);
+                remainder = value % den;
+            }
+            return {quotient, FixedUint(static_cast<uint64_t>(remainder))};
+        }
+
+        const uint32_t shift = std::countl_zero(other._limbs[den_size - 1]);
+        std::array<uint64_t, LIMBS> den{};
+        std::array<uint64_t, LIMBS + 1> num{};
+        for (size_t i = den_size; i-- > 0;)
+        {
+            den[i] = other._limbs[i] << shift;
+            if (shift != 0 && i > 0)
+            {
+                den[i] |= other._limbs[i - 1] >> (64 - shift);
+            }
+        }
+        num[LIMBS] = shift != 0 ? _limbs[LIMBS - 1] >> (64 - shift) : 0;
+        for (size_t i = LIMBS; i-- > 0;)
+        {
+            num[i] = _limbs[i] << shift;
+            if (shift != 0 && i > 0)
+            {
+                num[i] |= _limbs[i - 1] >> (64 - shift);
+            }
+        }
+
+        const uint64_t top = den[den_size - 1];
+        const uint64_t second = den[den_size - 2];
+        for (size_t j = LIMBS - den_size + 1; j-- > 0;)
+        {
+            const Uint128 head = (static_cast<Uint128>(num[j + den_size]) << 64) | num[j + den_size - 1];
+            Uint128 estimate = head / top;
+            Uint128 rest = head % top;
+            while ((estimate >> 64) != 0 ||
+                   estimate * second > ((rest << 64) | num[j + den_size - 2]))
+            {
+                --estimate;
+                rest += top;
+                if ((rest >> 64) != 0)
+                {
+                    break;
+                }
+            }
+
+            uint64_t carry = 0;
+            uint64_t borrow = 0;
+            for (size_t i = 0; i < den_size; ++i)
+            {
+                const Uint128 product = estimate * den[i] + carry;
+                carry = static_cast<uint64_t>(product >> 64);
+                const Uint128 difference = static_cast<Uint128>(num[i + j]) - static_cast<uint64_t>(product) - borrow;
+                num[i + j] = static_cast<uint64_t>(difference);
+                borrow = static_cast<uint64_t>(difference >> 64) & 1;
+            }
+            const Uint128 difference = static_cast<Uint128>(num[j + den_size]) - carry - borrow;
+            num[j + den_size] = static_cast<uint64_t>(difference);
+            quotient._limbs[j] = static_cast<uint64_t>(estimate);
+
+            // The estimate was one too large: add the divisor back.
+            if ((difference >> 64) != 0)
+            {
+                --quotient._limbs[j];
+                carry = 0;
+                for (size_t i = 0; i < den_size; ++i)
+                {
+                    const Uint128 sum = static_cast<Uint128>(num[i + j]) + den[i] + carry;
+                    num[i + j] = static_cast<uint64_t>(sum);
+                    carry = static_cast<uint64_t>(sum >> 64);
+                }
+                num[j + den_size] += carry;
+            }
+        }
+
+        FixedUint remainder;
+        for (size_t i = 0; i < den_size; ++i)
+        {
+            remainder._limbs[i] = num[i] >> shift;
+            if (shift != 0)
+            {
+                remainder._limbs[i] |= num[i + 1] << (64 - shift);
+            }
+        }
+        return {quotient, remainder};
+    }
+
+    // Square and multiply, wrapping like the other operators.
+    constexpr FixedUint pow(uint64_t exp) const
+    {
+        FixedUint res(1);
+        FixedUint base(*this);
+        while (exp != 0)
+        {
+            if ((exp & 1) != 0)
+            {
+                res *= base;
+            }
+            base *= base;
+            exp >>= 1;
+        }
+        return res;
+    }
+
+    constexpr bool operator==(const FixedUint& other) const { return _limbs == other._limbs; }
+
+    constexpr bool operator<(const FixedUint& other) const
+    {
+        for (size_t i = LIMBS; i-- > 0;)
+        {
+            if (_limbs[i] != other._limbs[i])
+            {
+                return _limbs[i] < other._limbs[i];
+            }
+        }
+        return false;
+    }
+
+    constexpr bool operator<=(const FixedUint& other) const { return !(other < *this); }
+    constexpr bool operator>(const FixedUint& other) const { return other < *this; }
+    constexpr bool operator>=(const FixedUint& other) const { return !(*this < other); }
+
+public:
+    // Throws std::invalid_argument on an empty string or a digit outside the base, and std::overflow_error when the
+    // value needs more than Bits bits. Usable in constant expressions, where either error fails the compilation.
+    static constexpr FixedUint from_string(const std::string_view str,
+                                           const BigUint::Base base = BigUint::Base::HEXADECIMAL)
+    {
+        return parse_digits(str, static_cast<uint32_t>(base), false);
+    }
+
+    // Parses the spelling of a C++ integer literal: 0x, 0b and leading-zero octal prefixes and ' separators.
+    static constexpr FixedUint from_literal(std::string_view str)
+    {
+        uint32_t radix = 10;
+        if (str.size() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))
+        {
+            radix = 16;
+            str.remove_prefix(2);
+        }
+        else if (str.size() > 2 && str[0] == '0' && (str[1] == 'b' || str[1] == 'B'))
+        {
+            radix = 2;
+            str.remove_prefix(2);
+        }
+        else if (str.size() > 1 && str[0] == '0')
+        {
+            radix = 8;
+            str.remove_prefix(1);
+        }
+        return parse_digits(str, radix, true);
+    }
+
+    BigUint to_big_uint() const { return BigUint(*this); }
+
+    std::string to_string(const BigUint::Base base = BigUint::Base::HEXADECIMAL) const
+    {
+        return to_big_uint().to_string(base);
+    }
+
+private:
+    template <size_t>
+    friend class FixedUint;
+
+    friend class BigUint;
+
+    // The extension keyword keeps -pedantic builds of including code quiet.
+    __extension__ typedef unsigned __int128 Uint128;
+
+    // Widths up to UNROLL_LIMIT limbs expand every step; wider ones keep the loop to bound the code size.
+    static constexpr size_t UNROLL_LIMIT = 16;
+
+    static constexpr uint32_t digit_value(const char digit)
+    {
+        if (digit >= '0' && digit <= '9')
+        {
+            return digit - '0';
+        }
+        if (digit >= 'a' && digit <= 'f')
+        {
+            return digit - 'a' + 10;
+        }
+        if (digit >= 'A' && digit <= 'F')
+        {
+            return digit - 'A' + 10;
+        }
+        return UINT32_MAX;
+    }
+
+    static constexpr FixedUint parse_digits(const std::string_view str, const uint32_t radix, const bool separators)
+    {
+        FixedUint res;
+        bool empty = true;
+        for (const char digit : str)
+        {
+            if (separators && digit == '\'')
+            {
+                continue;
+            }
+            const uint32_t value = digit_value(digit);
+            if (value >= radix)
+            {
+                throw std::invalid_argument("Invalid digit for the given base");
+            }
+            uint64_t carry = value;
+            for (size_t i = 0; i < LIMBS; ++i)
+            {
+                const Uint128 product = static_cast<Uint128>(res._limbs[i]) * radix + carry;
+                res._limbs[i] = static_cast<uint64_t>(product);
+                carry = static_cast<uint64_t>(product >> 64);
+            }
+            if (carry != 0)
+            {
+                throw std::overflow_error("Number does not fit the FixedUint width");
+            }
+            empty = false;
+        }
+        if (empty)
+        {
+            throw std::invalid_argument("Empty number string");
+        }
+        return res;
+    }
+
+    template <size_t Count, typename Step>
+    static constexpr void unroll(Step&& step)
+    {
+        if constexpr (Count <= UNROLL_LIMIT)
+        {
+            [&]<size_t... Indices>(std::index_sequence<Indices...>)
+            { (step(Indices), ...); }(std::make_index_sequence<Count>());
+        }
+        else
+        {
+            for (size_t i = 0; i < Count; ++i)
+            {
+                step(i);
+            }
+        }
+    }
+
+private:
+    std::array<uint64_t, LIMBS> _limbs;
+
+public:
+    constexpr FixedUint(const FixedUint&) = default;
+    constexpr FixedUint& operator=(const FixedUint&) = default;
+    constexpr FixedUint(FixedUint&&) noexcept = default;
+    constexpr FixedUint& operator=(FixedUint&&) noexcept = default;
+    constexpr ~FixedUint() = default;
+};
+
+// Values up to 256 bits fit the inline storage of BigUint, so the conversion does not allocate either.
+template <size_t Bits>
+BigUint::BigUint(const FixedUint<Bits>& other)
+{
+    _number.resize_for_overwrite(FixedUint<Bits>::LIMBS);
+    for (size_t i = 0; i < FixedUint<Bits>::LIMBS; ++i)
+    {
+        _number[i] = other._limbs[i];
+    }
+    fix_size();
+}
+
+namespace literals
+{
+// Integer literals of any length, parsed at compile time into the narrowest FixedUint that holds them, so constant
+// tables are plain data: 0xffff'ffff'ffff'ffff'ffff_big, 1'000'000'007_big, 0b1011_big.
+template <char... Chars>
+consteval auto operator""_big()
+{
+    constexpr std::array<char, sizeof...(Chars)> TEXT = {Chars...};
+    // No digit carries more than 4 bits, prefixes included.
+    constexpr size_t BOUND = (4 * sizeof...(Chars) + 63) / 64 * 64;
+    constexpr FixedUint<BOUND> VALUE = FixedUint<BOUND>::from_literal(std::string_view(TEXT.data(), TEXT.size()));
+    constexpr size_t WIDTH = VALUE.bit_width() <= 64 ? 64 : (VALUE.bit_width() + 63) / 64 * 64;
+    return FixedUint<WIDTH>(VALUE);
+}
+} // namespace literals
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Opt-in counters for the BigUint operations, compiled in with the BIGINT_INSTRUMENTATION CMake option. Without it
+// the hooks are empty inline functions and a snapshot reads all zeros.
+namespace instrumentation
+{
+#ifdef BIGINT_INSTRUMENTATION
+inline constexpr bool ENABLED = true;
+#else
+inline constexpr bool ENABLED = false;
+#endif
+
+enum class Operation : uint8_t
+{
+    ADD,
+    SUB,
+    MUL,
+    SQR,
+    DIV_AND_MOD,
+    GCD,
+    TO_STRING,
+    FROM_STRING,
+    SHIFT_LEFT,
+    SHIFT_RIGHT,
+    COUNT,
+};
+
+// Counted at every dispatch, so the recursive tiers also count the sub-products and sub-divisions they run.
+enum class Tier : uint8_t
+{
+    MUL_BASECASE,
+    MUL_KARATSUBA,
+    MUL_TOOM3,
+    MUL_TOOM4,
+    MUL_UNBALANCED,
+    MUL_NTT,
+    SQR_BASECASE,
+    SQR_KARATSUBA,
+    SQR_TOOM3,
+    SQR_TOOM4,
+    SQR_NTT,
+    DIV_LIMB,
+    DIV_SCHOOLBOOK,
+    DIV_DIVIDE_AND_CONQUER,
+    DIV_NEWTON,
+    GCD_LEHMER,
+    GCD_HALF_GCD,
+    RADIX_BASECASE,
+    RADIX_DIVIDE_AND_CONQUER,
+    COUNT,
+};
+
+inline constexpr size_t OPERATION_COUNT = static_cast<size_t>(Operation::COUNT);
+inline constexpr size_t TIER_COUNT = static_cast<size_t>(Tier::COUNT);
+// Bucket i counts operations whose largest operand has bit_width(limbs) == i + 1, that is [2^i, 2^(i+1)) limbs.
+inline constexpr size_t SIZE_BUCKETS = 40;
+
+// Time and allocations are inclusive: a gcd also counts the divisions it runs, which are counted again on their own.
+struct OperationStats final
+{
+    uint64_t calls = 0;
+    uint64_t nanoseconds = 0;
+    uint64_t allocations = 0;
+    std::array<uint64_t, SIZE_BUCKETS> sizes{};
+};
+
+struct Snapshot final
+{
+    std::array<OperationStats, OPERATION_COUNT> operations{};
+    std::array<uint64_t, TIER_COUNT> tiers{};
+    // Every limb buffer taken from the allocator, inside an operation or not.
+    uint64_t allocations = 0;
+
+    const OperationStats& operator[](const Operation operation) const
+    {
+        return operations[static_cast<size_t>(operation)];
+    }
+    uint64_t operator[](const Tier tier) const { return tiers[static_cast<size_t>(tier)]; }
+};
+
+Snapshot snapshot();
+void reset();
+const char* name(Operation operation);
+const char* name(Tier tier);
+
+void record_operation(Operation operation, size_t limbs, uint64_t nanoseconds, uint64_t allocations);
+void record_tier_slow(Tier tier);
+void record_allocation_slow();
+uint64_t thread_allocations();
+
+inline void record_tier([[maybe_unused]] const Tier tier)
+{
+    if constexpr (ENABLED)
+    {
+        record_tier_slow(tier);
+    }
+}
+
+inline void record_allocation()
+{
+    if constexpr (ENABLED)
+    {
+        record_allocation_slow();
+    }
+}
+
+// Records one call of an operation on operands of at most limbs limbs, timed from construction to destruction.
+class Scope final
+{
+public:
+#ifdef BIGINT_INSTRUMENTATION
+    Scope(const Operation operation, const size_t limbs)
+        : _operation(operation), _limbs(limbs), _allocations(thread_allocations()),
+          _start(std::chrono::steady_clock::now())
+    {
+    }
+#else
+    Scope(Operation /*operation*/, size_t /*limbs*/) {}
+#endif
+
+#ifdef BIGINT_INSTRUMENTATION
+private:
+    Operation _operation;
+    size_t _limbs;
+    uint64_t _allocations;
+    std::chrono::steady_clock::time_point _start;
+#endif
+
+public:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    Scope& operator=(Scope&&) = delete;
+
+#ifdef BIGINT_INSTRUMENTATION
+    ~Scope()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - _start;
+        record_operation(_operation, _limbs, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                         thread_allocations() - _allocations);
+    }
+#else
+    ~Scope() = default;
+#endif
+};
+} // namespace instrumentation
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+// Limb storage that keeps up to INLINE_CAPACITY limbs inside the object and only allocates above that.
+class LimbVector final
+{
+public:
+    static constexpr size_t INLINE_CAPACITY = 4;
+
+public:
+    LimbVector() = default;
+    LimbVector(size_t size, uint64_t value);
+    LimbVector(std::initializer_list<uint64_t> values);
+
+public:
+    uint64_t* data() { return _data; }
+    const uint64_t* data() const { return _data; }
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+    uint64_t& operator[](size_t index) { return _data[index]; }
+    const uint64_t& operator[](size_t index) const { return _data[index]; }
+    uint64_t& back() { return _data[_size - 1]; }
+    const uint64_t& back() const { return _data[_size - 1]; }
+    uint64_t* begin() { return _data; }
+    uint64_t* end() { return _data + _size; }
+    const uint64_t* begin() const { return _data; }
+    const uint64_t* end() const { return _data + _size; }
+    std::reverse_iterator<const uint64_t*> crbegin() const { return std::reverse_iterator<const uint64_t*>(end()); }
+    std::reverse_iterator<const uint64_t*> crend() const { return std::reverse_iterator<const uint64_t*>(begin()); }
+
+public:
+    void reserve(size_t capacity);
+    void resize(size_t size, uint64_t value = 0);
+    void assign(size_t size, uint64_t value);
+    void resize_for_overwrite(size_t size);
+    void push_back(uint64_t value);
+    void swap(LimbVector& other) noexcept;
+
+private:
+    bool is_inline() const { return _data == _inline; }
+    void release();
+
+private:
+    uint64_t* _data = _inline;
+    size_t _size = 0;
+    size_t _capacity = INLINE_CAPACITY;
+    uint64_t _inline[INLINE_CAPACITY];
+
+public:
+    LimbVector(const LimbVector& other);
+    LimbVector& operator=(const LimbVector& other);
+    LimbVector(LimbVector&& other) noexcept;
+    LimbVector& operator=(LimbVector&& other) noexcept;
+    ~LimbVector();
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "BigUint.hpp"
+
+// Arithmetic modulo an odd modulus m in Montgomery form x R mod m, R = 2^(64 n) for an n-limb modulus. Products are
+// reduced by REDC, which divides by R with multiplications only, instead of a full division.
+class MontgomeryContext final
+{
+public:
+    explicit MontgomeryContext(BigUint modulus);
+
+public:
+    BigUint to_montgomery(const BigUint& number) const;
+    BigUint from_montgomery(const BigUint& number) const;
+    // a b / R mod m, for a and b in Montgomery form.
+    BigUint multiply(const BigUint& a, const BigUint& b) const;
+    // base^exp mod m, with base and the result in normal form.
+    BigUint pow(const BigUint& base, const BigUint& exp) const;
+    constexpr const BigUint& modulus() const { return _modulus; }
+
+private:
+    size_t limb_count() const { return _modulus._number.size(); }
+    void load(uint64_t* res, const BigUint& number) const;
+    BigUint store(const uint64_t* number) const;
+    void mul(uint64_t* res, const uint64_t* a, const uint64_t* b, uint64_t* product) const;
+    void reduce(uint64_t* res, uint64_t* product) const;
+
+private:
+    BigUint _modulus;
+    BigUint _r_squared;
+    uint64_t _inverse;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include "BigUint.hpp"
+#include "limbs.hpp"
+
+class NttMultiplier final
+{
+public:
+    explicit NttMultiplier(BigUint operand, size_t max_other_size = 0);
+
+public:
+    BigUint multiply(const BigUint& other) const;
+    BigUint operator*(const BigUint& other) const { return multiply(other); }
+    constexpr const BigUint& operand() const { return _operand; }
+    constexpr size_t max_other_size() const { return _max_other_size; }
+
+private:
+    BigUint _operand;
+    size_t _max_other_size;
+    limbs::NttTransform _transform;
+};
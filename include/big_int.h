@@ -7,6 +7,10 @@ extern "C"
 {
     bool big_int_add(uint64_t* dest, size_t size, const uint64_t* addend, size_t addend_size);
     bool big_int_sub(uint64_t* dest, size_t size, const uint64_t* addend, size_t addend_size);
+    uint64_t big_int_mul_1(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_addmul_1(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_submul_1(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_redc_1(uint64_t* dest, uint64_t* product, const uint64_t* mod, size_t size, uint64_t inverse);
 }
 
 #else
@@ -14,4 +18,8 @@ extern "C"
 #include <stdint.h>
 uint64_t big_int_add(uint64_t* dest, size_t size, const uint64_t* addend, size_t addend_size);
 uint64_t big_int_sub(uint64_t* dest, size_t size, const uint64_t* addend, size_t addend_size);
-#endif
\ No newline at end of file
+uint64_t big_int_mul_1(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+uint64_t big_int_addmul_1(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+uint64_t big_int_submul_1(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+uint64_t big_int_redc_1(uint64_t* dest, uint64_t* product, const uint64_t* mod, size_t size, uint64_t inverse);
+#endif
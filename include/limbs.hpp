@@ -0,0 +1,176 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "LimbVector.hpp"
+
+namespace limbs
+{
+inline constexpr size_t KARATSUBA_THRESHOLD = 32;
+inline constexpr size_t TOOM3_THRESHOLD = 160;
+inline constexpr size_t TOOM4_THRESHOLD = 400;
+inline constexpr size_t NTT_THRESHOLD = 3000;
+inline constexpr size_t SQR_KARATSUBA_THRESHOLD = 48;
+inline constexpr size_t SQR_TOOM3_THRESHOLD = 200;
+inline constexpr size_t SQR_TOOM4_THRESHOLD = 500;
+inline constexpr size_t SQR_NTT_THRESHOLD = 3500;
+inline constexpr size_t DC_DIV_THRESHOLD = 50;
+inline constexpr size_t NEWTON_DIV_THRESHOLD = 3000;
+inline constexpr size_t NEWTON_DIV_MIN_BLOCKS = 4;
+inline constexpr size_t HGCD_THRESHOLD = 150;
+inline constexpr size_t PARALLEL_THRESHOLD = 1000;
+
+inline constexpr uint64_t DECIMAL_CHUNK = 10'000'000'000'000'000'000ULL;
+inline constexpr size_t DECIMAL_CHUNK_DIGITS = 19;
+
+// Moller-Granlund: the divisor shifted to set its top bit, with floor((B^2 - 1) / divisor) - B, so that dividing by it
+// takes two multiplications instead of a hardware divide.
+struct LimbDivisor final
+{
+    constexpr explicit LimbDivisor(const uint64_t den)
+        : shift(std::countl_zero(den)), divisor(den << shift),
+          inverse(static_cast<uint64_t>(((static_cast<__uint128_t>(~divisor) << 64) | ~0ULL) / divisor))
+    {
+    }
+
+    uint32_t shift;
+    uint64_t divisor;
+    uint64_t inverse;
+};
+
+struct NttTransform final
+{
+    size_t length = 0;
+    size_t source_size = 0;
+    LimbVector values;
+};
+
+struct ExecutionPolicy final
+{
+    enum class Mode : uint8_t
+    {
+        SEQUENTIAL,
+        PARALLEL,
+    };
+
+    Mode mode = Mode::PARALLEL;
+    // Threads including the calling one; 0 uses every hardware thread.
+    size_t threads = 0;
+    // Operations on fewer limbs never fork.
+    size_t min_limbs = PARALLEL_THRESHOLD;
+};
+
+// Variants of the multiplication kernels in big_int.s: plain mul, BMI2 mulx, and mulx with the ADX dual carry chains.
+enum class Kernel : uint8_t
+{
+    BASELINE,
+    MULX,
+    ADX,
+};
+
+struct Allocator final
+{
+    uint64_t* (*allocate)(size_t size);
+    void (*deallocate)(uint64_t* data, size_t size);
+};
+
+// Scratch limbs for one scope: everything allocated from the arena is released together when it is destroyed, and
+// the thread keeps the memory for the next arena. Only the innermost live arena of a thread may allocate.
+class ScratchArena final
+{
+public:
+    ScratchArena();
+
+public:
+    uint64_t* allocate(size_t size);
+
+private:
+    size_t _block;
+    size_t _offset;
+
+public:
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+    ScratchArena(ScratchArena&&) = delete;
+    ScratchArena& operator=(ScratchArena&&) = delete;
+    ~ScratchArena();
+};
+
+// Every limb buffer is allocated through the current allocator, a thread-local pool unless replaced. Buffers go back
+// to whichever allocator is current when they are freed, so replace it before the first allocation.
+Allocator pool_allocator();
+Allocator heap_allocator();
+void set_allocator(const Allocator& allocator);
+uint64_t* allocate(size_t size);
+void deallocate(uint64_t* data, size_t size);
+
+// Independent sub-operations of at least min_limbs limbs run on a shared work-stealing pool. A fork only hands work
+// to threads that are idle at that moment and the forking thread runs everything nobody took, so a process that is
+// already saturated keeps running sequentially. Change the policy while no arithmetic is running.
+ExecutionPolicy execution_policy();
+void set_execution_policy(const ExecutionPolicy& policy);
+bool parallel_worthwhile(size_t size);
+void parallel_for(size_t count, void (*body)(void* context, size_t index), void* context);
+
+// Runs body(0) .. body(count - 1), in parallel when an operation on size limbs is worth forking. Exceptions thrown
+// by any index are rethrown once all of them finished.
+template <typename Body>
+void parallel_for(const size_t count, const size_t size, Body&& body)
+{
+    if (count < 2 || !parallel_worthwhile(size))
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            body(i);
+        }
+        return;
+    }
+
+    parallel_for(
+        count, [](void* context, const size_t index) { (*static_cast<std::remove_reference_t<Body>*>(context))(index); },
+        &body);
+}
+
+// The fastest kernel the CPU supports is selected at startup, or the one named by BIGINT_FORCE_KERNEL when the CPU
+// has it. Change the kernel while no arithmetic is running.
+Kernel kernel();
+bool kernel_supported(Kernel kernel);
+void set_kernel(Kernel kernel);
+const char* kernel_name(Kernel kernel);
+
+uint64_t add_limb(uint64_t* res, size_t size, uint64_t carry);
+uint64_t sub_limb(uint64_t* res, size_t size, uint64_t borrow);
+void negate(uint64_t* res, size_t size);
+void divexact_1(uint64_t* res, size_t size, uint64_t divisor);
+uint64_t lshift(uint64_t* res, const uint64_t* a, size_t size, uint32_t bits);
+uint64_t rshift(uint64_t* res, const uint64_t* a, size_t size, uint32_t bits);
+int cmp(const uint64_t* a, const uint64_t* b, size_t size);
+
+void mul(uint64_t* res, const uint64_t* a, size_t a_size, const uint64_t* b, size_t b_size);
+void sqr(uint64_t* res, const uint64_t* a, size_t size);
+
+uint64_t div_1(uint64_t* quotient, const uint64_t* num, size_t size, const LimbDivisor& den);
+uint64_t div_1(uint64_t* quotient, const uint64_t* num, size_t size, uint64_t den);
+uint64_t mod_1(const uint64_t* num, size_t size, uint64_t den);
+void reciprocal(uint64_t* res, const uint64_t* den, size_t size);
+void divrem(uint64_t* quotient, uint64_t* remainder, const uint64_t* num, size_t num_size, const uint64_t* den,
+            size_t den_size);
+
+// Batches of count independent numbers of size limbs each, stored limb-major: limb j of item i is at [j * count + i].
+// The carries, borrows and comparison results are per item, and the carry pointers may be null.
+void batch_add(uint64_t* res, const uint64_t* a, size_t size, size_t count, uint64_t* carries);
+void batch_sub(uint64_t* res, const uint64_t* a, size_t size, size_t count, uint64_t* borrows);
+void batch_mul_1(uint64_t* res, const uint64_t* a, size_t size, size_t count, const uint64_t* factors,
+                 uint64_t* carries);
+void batch_addmul_1(uint64_t* res, const uint64_t* a, size_t size, size_t count, const uint64_t* factors,
+                    uint64_t* carries);
+void batch_cmp(const uint64_t* a, const uint64_t* b, size_t size, size_t count, int8_t* res);
+
+size_t ntt_length(size_t res_size);
+void ntt_forward(NttTransform& transform, const uint64_t* a, size_t a_size, size_t length);
+void ntt_mul(uint64_t* res, const NttTransform& a_transform, const uint64_t* b, size_t b_size);
+void mul_ntt(uint64_t* res, const uint64_t* a, size_t a_size, const uint64_t* b, size_t b_size);
+void sqr_ntt(uint64_t* res, const uint64_t* a, size_t size);
+} // namespace limbs
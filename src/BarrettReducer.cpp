@@ -0,0 +1,171 @@
+#include "BarrettReducer.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "BigUint.hpp"
+#include "big_int.h"
+#include "limbs.hpp"
+
+namespace
+{
+inline constexpr size_t SHORT_PRODUCT_THRESHOLD = 120;
+
+// The product of two (n + 1)-limb values without the columns below n - 1. The dropped part is below n B^n, so limbs
+// n + 1 and up are at most one below the exact product.
+void mul_high(uint64_t* res, const uint64_t* a, const uint64_t* b, const size_t size)
+{
+    if (size >= SHORT_PRODUCT_THRESHOLD)
+    {
+        limbs::mul(res, a, size + 1, b, size + 1);
+        return;
+    }
+
+    std::fill(res, res + 2 * size + 2, 0);
+    for (size_t i = 0; i <= size; ++i)
+    {
+        const size_t first = i + 1 < size ? size - 1 - i : 0;
+        res[i + size + 1] = big_int_addmul_1(res + i + first, b + first, size + 1 - first, a[i]);
+    }
+}
+
+// The low n + 1 limbs of an n-limb by n-limb product.
+void mul_low(uint64_t* res, const uint64_t* a, const uint64_t* b, const size_t size, uint64_t* product)
+{
+    if (size >= SHORT_PRODUCT_THRESHOLD)
+    {
+        limbs::mul(product, a, size, b, size);
+        std::copy(product, product + size + 1, res);
+        return;
+    }
+
+    res[size] = big_int_mul_1(res, b, size, a[0]);
+    for (size_t i = 1; i < size; ++i)
+    {
+        big_int_addmul_1(res + i, b, size + 1 - i, a[i]);
+    }
+}
+} // namespace
+
+BarrettReducer::BarrettReducer(BigUint modulus) : _modulus(std::move(modulus)), _shift(0)
+{
+    if (_modulus.is_zero())
+    {
+        throw std::invalid_argument("Division by zero is undefined");
+    }
+
+    const size_t size = limb_count();
+    _shift = std::countl_zero(_modulus._number.back());
+    _normalized.resize_for_overwrite(size);
+    if (_shift == 0)
+    {
+        std::copy(_modulus._number.begin(), _modulus._number.end(), _normalized.data());
+    }
+    else
+    {
+        limbs::lshift(_normalized.data(), _modulus._number.data(), size, _shift);
+    }
+    _reciprocal.resize_for_overwrite(size + 1);
+    limbs::reciprocal(_reciprocal.data(), _normalized.data(), size);
+}
+
+BigUint BarrettReducer::reduce(const BigUint& number) const
+{
+    if (number < _modulus)
+    {
+        return number;
+    }
+
+    BigUint res;
+    if (!reduce_limbs(res, number._number.data(), number._number.size()))
+    {
+        res = number % _modulus;
+    }
+    return res;
+}
+
+BigUint BarrettReducer::mulmod(const BigUint& a, const BigUint& b) const
+{
+    if (a >= _modulus || b >= _modulus)
+    {
+        return mulmod(reduce(a), reduce(b));
+    }
+
+    const size_t product_size = a._number.size() + b._number.size();
+    limbs::ScratchArena arena;
+    uint64_t* const product = arena.allocate(product_size);
+    limbs::mul(product, a._number.data(), a._number.size(), b._number.data(), b._number.size());
+    BigUint res;
+    reduce_limbs(res, product, product_size);
+    return res;
+}
+
+BigUint BarrettReducer::addmod(const BigUint& a, const BigUint& b) const
+{
+    BigUint res = reduce(a) + reduce(b);
+    if (res >= _modulus)
+    {
+        res -= _modulus;
+    }
+    return res;
+}
+
+// With x = number << shift below m' B^n for the normalized m', the quotient estimate floor(x_top R / B^(n+1)) from
+// the top n + 1 limbs is at most two below the true quotient (HAC 14.42), three with the truncated product. Returns
+// false, leaving res untouched, for numbers outside that range.
+bool BarrettReducer::reduce_limbs(BigUint& res, const uint64_t* number, size_t number_size) const
+{
+    const size_t size = limb_count();
+    while (number_size > 1 && number[number_size - 1] == 0)
+    {
+        --number_size;
+    }
+    if (number_size > 2 * size)
+    {
+        return false;
+    }
+
+    limbs::ScratchArena arena;
+    uint64_t* const num = arena.allocate(2 * size + 1);
+    std::fill(num + number_size, num + 2 * size + 1, 0);
+    if (_shift == 0)
+    {
+        std::copy(number, number + number_size, num);
+    }
+    else
+    {
+        num[number_size] = limbs::lshift(num, number, number_size, _shift);
+    }
+    const uint64_t* const den = _normalized.data();
+    if (num[2 * size] != 0 || limbs::cmp(num + size, den, size) >= 0)
+    {
+        return false;
+    }
+
+    // Only the low n + 1 limbs of num - q m' are needed: the difference is below 4 m' < B^(n+1).
+    uint64_t* const product = arena.allocate(4 * size + 3);
+    uint64_t* const estimate = product + 2 * size + 2;
+    uint64_t* const low = estimate + size;
+    mul_high(product, num + size - 1, _reciprocal.data(), size);
+    std::copy(product + size + 1, product + 2 * size + 1, estimate);
+    mul_low(low, estimate, den, size, product);
+    big_int_sub(num, size + 1, low, size + 1);
+    while (num[size] != 0 || limbs::cmp(num, den, size) >= 0)
+    {
+        num[size] -= big_int_sub(num, size, den, size);
+    }
+
+    res._number.resize_for_overwrite(size);
+    if (_shift == 0)
+    {
+        std::copy(num, num + size, res._number.data());
+    }
+    else
+    {
+        limbs::rshift(res._number.data(), num, size, _shift);
+    }
+    res.fix_size();
+    return true;
+}
@@ -1,6 +1,13 @@
 #include "BigInt.hpp"
+#include <charconv>
 #include <cstdlib>
+#include <ios>
+#include <istream>
 #include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
 #include <utility>
 #include "BigUint.hpp"
 
@@ -114,83 +121,190 @@ BigInt& BigInt::operator%=(const BigInt& other) &
     return *this;
 }
 
-BigInt BigInt::operator+(const BigInt& other) const
+BigInt BigInt::operator+(const BigInt& other) const&
 {
     BigInt temp(*this);
     temp += other;
     return temp;
 }
 
-BigInt BigInt::operator-(const BigInt& other) const
+BigInt BigInt::operator-(const BigInt& other) const&
 {
     BigInt temp(*this);
     temp -= other;
     return temp;
 }
 
-BigInt BigInt::operator-() const
+BigInt BigInt::operator-() const&
 {
     BigInt temp(*this);
-    temp._is_negative = !_is_negative;
+    temp._is_negative = !_is_negative && !_number.is_zero();
     return temp;
 }
 
-BigInt BigInt::operator>>(size_t bits) const
+BigInt BigInt::operator>>(size_t bits) const&
 {
     BigInt temp(*this);
     temp >>= bits;
     return temp;
 }
 
-BigInt BigInt::operator<<(size_t bits) const
+BigInt BigInt::operator<<(size_t bits) const&
 {
     BigInt temp(*this);
     temp <<= bits;
     return temp;
 }
 
-BigInt BigInt::operator*(const BigInt& other) const
+BigInt BigInt::operator*(const BigInt& other) const&
 {
     BigInt temp(*this);
     temp *= other;
     return temp;
 }
 
-BigInt BigInt::operator*(const BigUint& other) const
+BigInt BigInt::operator*(const BigUint& other) const&
 {
     BigInt temp(*this);
     temp *= other;
     return temp;
 }
 
-BigInt BigInt::operator*(uint64_t number) const
+BigInt BigInt::operator*(uint64_t number) const&
 {
     BigInt temp(*this);
     temp *= number;
     return temp;
 }
 
-BigInt BigInt::operator/(const BigInt& other) const
+BigInt BigInt::operator/(const BigInt& other) const&
 {
     BigInt temp(*this);
     temp /= other;
     return temp;
 }
 
-BigInt BigInt::operator/(const BigUint& other) const
+BigInt BigInt::operator/(const BigUint& other) const&
 {
     BigInt temp(*this);
     temp /= other;
     return temp;
 }
 
-BigInt BigInt::operator%(const BigInt& other) const
+BigInt BigInt::operator%(const BigInt& other) const&
 {
     BigInt temp(*this);
     temp %= other;
     return temp;
 }
 
+BigInt BigInt::operator+(const BigInt& other) &&
+{
+    *this += other;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator-(const BigInt& other) &&
+{
+    *this -= other;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator-() &&
+{
+    _is_negative = !_is_negative && !_number.is_zero();
+    return std::move(*this);
+}
+
+BigInt BigInt::operator>>(size_t bits) &&
+{
+    *this >>= bits;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator<<(size_t bits) &&
+{
+    *this <<= bits;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator*(const BigInt& other) &&
+{
+    *this *= other;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator*(const BigUint& other) &&
+{
+    *this *= other;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator*(uint64_t number) &&
+{
+    *this *= number;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator/(const BigInt& other) &&
+{
+    *this /= other;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator/(const BigUint& other) &&
+{
+    *this /= other;
+    return std::move(*this);
+}
+
+BigInt BigInt::operator%(const BigInt& other) &&
+{
+    *this %= other;
+    return std::move(*this);
+}
+
+void BigInt::add(BigInt& dest, const BigInt& a, const BigInt& b)
+{
+    if (&dest == &b)
+    {
+        dest += a;
+        return;
+    }
+
+    dest = a;
+    dest += b;
+}
+
+void BigInt::sub(BigInt& dest, const BigInt& a, const BigInt& b)
+{
+    if (&dest == &b && &dest != &a)
+    {
+        dest -= a;
+        dest._is_negative = !dest._is_negative && !dest.is_zero();
+        return;
+    }
+
+    dest = a;
+    dest -= b;
+}
+
+void BigInt::mul(BigInt& dest, const BigInt& a, const BigInt& b)
+{
+    const bool is_negative = a._is_negative != b._is_negative;
+    BigUint::mul(dest._number, a._number, b._number);
+    dest._is_negative = is_negative && !dest._number.is_zero();
+}
+
+void BigInt::divmod(BigInt& quotient, BigInt& remainder, const BigInt& a, const BigInt& b)
+{
+    const bool quotient_negative = a._is_negative != b._is_negative;
+    const bool remainder_negative = a._is_negative;
+    BigUint::divmod(quotient._number, remainder._number, a._number, b._number);
+    quotient._is_negative = quotient_negative && !quotient._number.is_zero();
+    remainder._is_negative = remainder_negative && !remainder._number.is_zero();
+}
+
 bool BigInt::is_zero() const
 {
     return _number.is_zero();
@@ -209,9 +323,9 @@ BigInt& BigInt::negate() &
 
 std::pair<BigInt, BigInt> BigInt::div_and_mod(const BigInt& other) const
 {
-    std::pair<BigUint, BigUint> ures = _number.div_and_mod(other._number);
-    return {BigInt{std::move(ures.first), _is_negative != other._is_negative},
-            BigInt{std::move(ures.second), _is_negative != other._is_negative}};
+    std::pair<BigInt, BigInt> res;
+    divmod(res.first, res.second, *this, other);
+    return res;
 }
 
 BigInt BigInt::gcd(const BigInt& other) const
@@ -224,6 +338,27 @@ BigInt BigInt::lcm(const BigInt& other) const
     return BigInt{_number.lcm(other._number), _is_negative || other._is_negative};
 }
 
+BigInt BigInt::square() const
+{
+    return BigInt(_number.square());
+}
+
+BigInt BigInt::pow(const uint64_t exponent) const
+{
+    return BigInt(_number.pow(exponent), _is_negative && exponent % 2 == 1);
+}
+
+BigInt BigInt::pow_mod(const BigInt& base, const BigInt& exp, const BigInt& mod)
+{
+    const BigInt& positive_base = exp._is_negative ? base.mod_inverse(mod) : base;
+    BigUint reduced = positive_base._number % mod._number;
+    if (positive_base._is_negative && !reduced.is_zero())
+    {
+        reduced = mod._number - reduced;
+    }
+    return BigInt(BigUint::pow_mod(reduced, exp._number, mod._number));
+}
+
 bool BigInt::operator==(const BigInt& other) const
 {
     return _is_negative == other._is_negative && _number == other._number;
@@ -249,6 +384,69 @@ bool BigInt::operator<=(const BigInt& other) const
     return !other._is_negative && (_number <= other._number);
 }
 
+std::string BigInt::to_string(const BigUint::Base base) const
+{
+    return _is_negative ? '-' + _number.to_string(base) : _number.to_string(base);
+}
+
+BigInt BigInt::from_string(const std::string_view str, const BigUint::Base base)
+{
+    BigInt res;
+    const std::from_chars_result result = from_chars(str.data(), str.data() + str.size(), res, base);
+    if (result.ec != std::errc() || result.ptr != str.data() + str.size())
+    {
+        throw std::invalid_argument("Invalid BigInt string");
+    }
+    return res;
+}
+
+std::from_chars_result BigInt::from_chars(const char* first, const char* last, BigInt& value, const BigUint::Base base)
+{
+    const bool is_negative = first != last && *first == '-';
+    const char* const digits = first != last && (*first == '-' || *first == '+') ? first + 1 : first;
+
+    BigUint magnitude;
+    const std::from_chars_result result = BigUint::from_chars(digits, last, magnitude, base);
+    if (result.ec != std::errc())
+    {
+        return {first, result.ec};
+    }
+
+    const bool negative_result = is_negative && !magnitude.is_zero();
+    value = BigInt(std::move(magnitude), negative_result);
+    return result;
+}
+
+std::basic_istream<char>& operator>>(std::basic_istream<char>& stream, BigInt& num)
+{
+    const std::basic_istream<char>::sentry sentry(stream);
+    if (!sentry)
+    {
+        return stream;
+    }
+
+    const int sign = stream.peek();
+    const bool is_negative = sign == '-';
+    if (sign == '-' || sign == '+')
+    {
+        stream.get();
+    }
+
+    const std::ios_base::fmtflags flags = stream.flags();
+    BigUint magnitude;
+    stream.unsetf(std::ios_base::skipws);
+    stream >> magnitude;
+    stream.flags(flags);
+    if (stream.fail())
+    {
+        return stream;
+    }
+
+    const bool negative_result = is_negative && !magnitude.is_zero();
+    num = BigInt(std::move(magnitude), negative_result);
+    return stream;
+}
+
 std::basic_ostream<char>& operator<<(std::basic_ostream<char>& stream, const BigInt& num)
 {
     if (num._is_negative)
@@ -1,8 +1,64 @@
 #include "BigRational.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <utility>
 #include "BigUint.hpp"
 
+using Uint128 = unsigned __int128;
+
+static constexpr size_t LEADING_BITS = 63;
+// Operands that agree in their leading 126 bits typically share dozens of partial quotients, so only a few steps are
+// tried, for the values whose expansions have large terms. Below this many limbs even those few divisions cost more
+// than the two cross products.
+static constexpr size_t CONTINUED_FRACTION_LIMBS = 1000;
+static constexpr size_t CONTINUED_FRACTION_STEPS = 4;
+
+static std::atomic<BigRational::Normalization::Mode> normalization_mode = BigRational::Normalization().mode;
+static std::atomic<size_t> normalization_growth_bits = BigRational::Normalization().growth_bits;
+
+static bool always_normalize()
+{
+    return normalization_mode.load(std::memory_order_relaxed) == BigRational::Normalization::Mode::ALWAYS;
+}
+
+static size_t countl_zero(const Uint128 number)
+{
+    const auto high = static_cast<uint64_t>(number >> 64);
+    return high != 0 ? std::countl_zero(high) : 64 + std::countl_zero(static_cast<uint64_t>(number));
+}
+
+// x * 2^x_shift < y * 2^y_shift
+static bool scaled_less(const Uint128 x, const size_t x_shift, const Uint128 y, const size_t y_shift)
+{
+    if (x == 0 || y == 0)
+    {
+        return x == 0 && y != 0;
+    }
+    if (x_shift >= y_shift)
+    {
+        const size_t shift = x_shift - y_shift;
+        return shift <= countl_zero(x) && (x << shift) < y;
+    }
+    const size_t shift = y_shift - x_shift;
+    return shift > countl_zero(y) || x < (y << shift);
+}
+
+// Sign of a * b - c * d.
+static int compare_products(const BigUint& a, const BigUint& b, const BigUint& c, const BigUint& d)
+{
+    const BigUint left = a * b;
+    const BigUint right = c * d;
+    if (left == right)
+    {
+        return 0;
+    }
+    return left < right ? -1 : 1;
+}
+
 BigRational::BigRational() : BigRational(0) {}
 
 BigRational::BigRational(int64_t numerator) : BigRational(numerator, 1) {}
@@ -10,102 +66,219 @@ BigRational::BigRational(int64_t numerator) : BigRational(numerator, 1) {}
 BigRational::BigRational(BigInt numerator) : BigRational(std::move(numerator), 1) {}
 
 BigRational::BigRational(BigInt numerator, BigUint denominator)
-    : _numerator(std::move(numerator)), _denominator(std::move(denominator))
+    : _numerator(std::move(numerator)), _denominator(std::move(denominator)), _reduced_bits(0)
 {
     if (_denominator.is_zero())
     {
         throw std::invalid_argument("Denominator cannot be zero");
     }
+    normalize();
 }
 
 BigRational& BigRational::operator+=(const BigRational& other) &
 {
-    _numerator *= other._denominator;
-    _numerator += other._numerator * _denominator;
-    _denominator *= other._denominator;
+    add(other, false);
     return *this;
 }
 
 BigRational& BigRational::operator-=(const BigRational& other) &
 {
-    _numerator *= other._denominator;
-    _numerator -= other._numerator * _denominator;
-    _denominator *= other._denominator;
+    add(other, true);
     return *this;
 }
 
+// With both operands in lowest terms, a/b * c/d = (a / gcd(a, d)) * (c / gcd(c, b)) / ((b / gcd(c, b)) *
+// (d / gcd(a, d))) is in lowest terms too, and the gcds run on the operands rather than on the twice as long product.
 BigRational& BigRational::operator*=(const BigRational& other) &
 {
-    _numerator *= other._numerator;
-    _denominator *= other._denominator;
+    if (_numerator.is_zero() || other._numerator.is_zero())
+    {
+        set_zero();
+        return *this;
+    }
+    if (!always_normalize())
+    {
+        _numerator *= other._numerator;
+        _denominator *= other._denominator;
+        normalize();
+        return *this;
+    }
+
+    const BigUint gcd_ad = _numerator.abs().gcd(other._denominator);
+    const BigUint gcd_cb = other._numerator.abs().gcd(_denominator);
+    BigInt numerator = (_numerator / gcd_ad) * (other._numerator / gcd_cb);
+    BigUint denominator = (_denominator / gcd_cb) * (other._denominator / gcd_ad);
+    _numerator = std::move(numerator);
+    _denominator = std::move(denominator);
+    _reduced_bits = bit_size();
     return *this;
 }
 
 BigRational& BigRational::operator*=(const uint64_t number) &
 {
-    _numerator *= number;
+    if (number == 0 || _numerator.is_zero())
+    {
+        set_zero();
+        return *this;
+    }
+    if (!always_normalize())
+    {
+        _numerator *= number;
+        normalize();
+        return *this;
+    }
+
+    const BigUint gcd = _denominator.gcd(number);
+    _denominator /= gcd;
+    _numerator *= BigUint(number) / gcd;
+    _reduced_bits = bit_size();
     return *this;
 }
 
+// Division is multiplication by the reciprocal, with the sign of c moved to the numerator.
 BigRational& BigRational::operator/=(const BigRational& other) &
 {
-    _numerator *= other._denominator;
-    _denominator *= other._numerator.abs();
-    if (other._numerator.is_neg())
+    if (other._numerator.is_zero())
+    {
+        throw std::invalid_argument("Division by zero is undefined");
+    }
+    if (_numerator.is_zero())
+    {
+        set_zero();
+        return *this;
+    }
+
+    const bool negate = other._numerator.is_neg();
+    if (!always_normalize())
+    {
+        BigUint denominator = _denominator * other._numerator.abs();
+        _numerator *= other._denominator;
+        _denominator = std::move(denominator);
+        if (negate)
+        {
+            _numerator.negate();
+        }
+        normalize();
+        return *this;
+    }
+
+    const BigUint gcd_ac = _numerator.abs().gcd(other._numerator.abs());
+    const BigUint gcd_bd = _denominator.gcd(other._denominator);
+    BigInt numerator = (_numerator / gcd_ac) * (other._denominator / gcd_bd);
+    BigUint denominator = (_denominator / gcd_bd) * (other._numerator.abs() / gcd_ac);
+    _numerator = std::move(numerator);
+    _denominator = std::move(denominator);
+    if (negate)
     {
         _numerator.negate();
     }
+    _reduced_bits = bit_size();
     return *this;
 }
 
 BigRational& BigRational::operator/=(const uint64_t number) &
 {
-    _denominator *= number;
+    if (number == 0)
+    {
+        throw std::invalid_argument("Division by zero is undefined");
+    }
+    if (_numerator.is_zero())
+    {
+        set_zero();
+        return *this;
+    }
+    if (!always_normalize())
+    {
+        _denominator *= number;
+        normalize();
+        return *this;
+    }
+
+    const BigUint gcd = _numerator.abs().gcd(number);
+    _numerator /= gcd;
+    _denominator *= BigUint(number) / gcd;
+    _reduced_bits = bit_size();
     return *this;
 }
 
-BigRational BigRational::operator+(const BigRational& other) const
+BigRational BigRational::operator+(const BigRational& other) const&
 {
     BigRational temp(*this);
     temp += other;
     return temp;
 }
 
-BigRational BigRational::operator-(const BigRational& other) const
+BigRational BigRational::operator-(const BigRational& other) const&
 {
     BigRational temp(*this);
     temp -= other;
     return temp;
 }
 
-BigRational BigRational::operator*(const BigRational& other) const
+BigRational BigRational::operator*(const BigRational& other) const&
 {
     BigRational temp(*this);
     temp *= other;
     return temp;
 }
 
-BigRational BigRational::operator*(const uint64_t number) const
+BigRational BigRational::operator*(const uint64_t number) const&
 {
     BigRational temp(*this);
     temp *= number;
     return temp;
 }
 
-BigRational BigRational::operator/(const BigRational& other) const
+BigRational BigRational::operator/(const BigRational& other) const&
 {
     BigRational temp(*this);
     temp /= other;
     return temp;
 }
 
-BigRational BigRational::operator/(const uint64_t number) const
+BigRational BigRational::operator/(const uint64_t number) const&
 {
     BigRational temp(*this);
     temp /= number;
     return temp;
 }
 
+BigRational BigRational::operator+(const BigRational& other) &&
+{
+    *this += other;
+    return std::move(*this);
+}
+
+BigRational BigRational::operator-(const BigRational& other) &&
+{
+    *this -= other;
+    return std::move(*this);
+}
+
+BigRational BigRational::operator*(const BigRational& other) &&
+{
+    *this *= other;
+    return std::move(*this);
+}
+
+BigRational BigRational::operator*(const uint64_t number) &&
+{
+    *this *= number;
+    return std::move(*this);
+}
+
+BigRational BigRational::operator/(const BigRational& other) &&
+{
+    *this /= other;
+    return std::move(*this);
+}
+
+BigRational BigRational::operator/(const uint64_t number) &&
+{
+    *this /= number;
+    return std::move(*this);
+}
+
 bool BigRational::is_zero() const
 {
     return _numerator.is_zero();
@@ -116,24 +289,263 @@ bool BigRational::raw_equal(const BigRational& other) const
     return _numerator == other._numerator && _denominator == other._denominator;
 }
 
+int BigRational::compare(const BigRational& other) const
+{
+    const int sign = _numerator.is_zero() ? 0 : (_numerator.is_neg() ? -1 : 1);
+    const int other_sign = other._numerator.is_zero() ? 0 : (other._numerator.is_neg() ? -1 : 1);
+    if (sign != other_sign)
+    {
+        return sign < other_sign ? -1 : 1;
+    }
+    if (sign == 0)
+    {
+        return 0;
+    }
+    return sign * compare_magnitudes(_numerator.abs(), _denominator, other._numerator.abs(), other._denominator);
+}
+
 bool BigRational::operator==(const BigRational& other) const
 {
-    return _numerator * other._denominator == other._numerator * _denominator;
+    return compare(other) == 0;
 }
 
 bool BigRational::operator<(const BigRational& other) const
 {
-    return _numerator * other._denominator < other._numerator * _denominator;
+    return compare(other) < 0;
 }
 
 bool BigRational::operator<=(const BigRational& other) const
 {
-    return _numerator * other._denominator <= other._numerator * _denominator;
+    return compare(other) <= 0;
 }
 
 void BigRational::minimize()
 {
-    const BigUint gcd = _denominator.gcd(_numerator.abs());
-    _denominator /= gcd;
-    _numerator /= gcd;
+    if (_numerator.is_zero())
+    {
+        set_zero();
+        return;
+    }
+    if (_denominator != 1)
+    {
+        const BigUint gcd = _denominator.gcd(_numerator.abs());
+        _denominator /= gcd;
+        _numerator /= gcd;
+    }
+    _reduced_bits = bit_size();
+}
+
+BigRational::Normalization BigRational::normalization()
+{
+    return {normalization_mode.load(std::memory_order_relaxed),
+            normalization_growth_bits.load(std::memory_order_relaxed)};
+}
+
+void BigRational::set_normalization(const Normalization& policy)
+{
+    normalization_mode.store(policy.mode, std::memory_order_relaxed);
+    normalization_growth_bits.store(policy.growth_bits, std::memory_order_relaxed);
+}
+
+// a/b + c/d with g = gcd(b, d): t = a * (d / g) + c * (b / g) shares no factor with b / g or d / g, so only
+// gcd(t, g) is left to divide out, and both gcds run on operands no longer than the denominators. Every product is
+// formed before *this changes, so other may alias it.
+void BigRational::add(const BigRational& other, const bool subtract)
+{
+    if (!always_normalize())
+    {
+        BigInt cross = other._numerator * _denominator;
+        _numerator *= other._denominator;
+        if (subtract)
+        {
+            _numerator -= cross;
+        }
+        else
+        {
+            _numerator += cross;
+        }
+        _denominator *= other._denominator;
+        normalize();
+        return;
+    }
+
+    const BigUint gcd = _denominator.gcd(other._denominator);
+    if (gcd == 1)
+    {
+        BigInt cross = other._numerator * _denominator;
+        _numerator *= other._denominator;
+        if (subtract)
+        {
+            _numerator -= cross;
+        }
+        else
+        {
+            _numerator += cross;
+        }
+        _denominator *= other._denominator;
+        if (_numerator.is_zero())
+        {
+            set_zero();
+        }
+        _reduced_bits = bit_size();
+        return;
+    }
+
+    const BigUint scale = _denominator / gcd;
+    BigInt sum = _numerator * (other._denominator / gcd);
+    if (subtract)
+    {
+        sum -= other._numerator * scale;
+    }
+    else
+    {
+        sum += other._numerator * scale;
+    }
+    if (sum.is_zero())
+    {
+        set_zero();
+        return;
+    }
+
+    const BigUint common = sum.abs().gcd(gcd);
+    BigUint denominator = scale * (other._denominator / common);
+    _numerator = std::move(sum) / common;
+    _denominator = std::move(denominator);
+    _reduced_bits = bit_size();
+}
+
+// Compares a/b with c/d for nonzero a and c, that is a * d with c * b.
+int BigRational::compare_magnitudes(const BigUint& a, const BigUint& b, const BigUint& c, const BigUint& d)
+{
+    // a * d has wa + wd - 1 or wa + wd bits.
+    const size_t left_width = a.bit_width() + d.bit_width();
+    const size_t right_width = c.bit_width() + b.bit_width();
+    if (left_width + 1 < right_width)
+    {
+        return -1;
+    }
+    if (right_width + 1 < left_width)
+    {
+        return 1;
+    }
+
+    // Each operand lies in [top, top + 1) * 2^shift for its leading 63 bits top, or equals top when the shift is 0,
+    // so the products are bracketed by 126-bit bounds.
+    const auto bound = [](const BigUint& x, const BigUint& y, Uint128& low, Uint128& high, size_t& shift)
+    {
+        const size_t x_shift = x.bit_width() > LEADING_BITS ? x.bit_width() - LEADING_BITS : 0;
+        const size_t y_shift = y.bit_width() > LEADING_BITS ? y.bit_width() - LEADING_BITS : 0;
+        const uint64_t x_top = leading_bits(x, x_shift);
+        const uint64_t y_top = leading_bits(y, y_shift);
+        low = static_cast<Uint128>(x_top) * y_top;
+        high = static_cast<Uint128>(x_top + (x_shift != 0 ? 1 : 0)) * (y_top + (y_shift != 0 ? 1 : 0));
+        shift = x_shift + y_shift;
+    };
+    Uint128 left_low;
+    Uint128 left_high;
+    Uint128 right_low;
+    Uint128 right_high;
+    size_t left_shift;
+    size_t right_shift;
+    bound(a, d, left_low, left_high, left_shift);
+    bound(c, b, right_low, right_high, right_shift);
+    if (scaled_less(left_high, left_shift, right_low, right_shift))
+    {
+        return -1;
+    }
+    if (scaled_less(right_high, right_shift, left_low, left_shift))
+    {
+        return 1;
+    }
+    if (left_low == left_high && right_low == right_high)
+    {
+        return 0;
+    }
+    // Values this close are usually equal, and equal values in lowest terms have equal parts.
+    if (a == c && b == d)
+    {
+        return 0;
+    }
+
+    if (std::max({a._number.size(), b._number.size(), c._number.size(), d._number.size()}) < CONTINUED_FRACTION_LIMBS)
+    {
+        return compare_products(a, d, c, b);
+    }
+
+    // p/q and r/s are complete quotients of a/b and c/d at the same depth. Each step compares their integer parts
+    // and moves on to the reciprocals of the fractional parts, which reverses the order.
+    BigUint p = a;
+    BigUint q = b;
+    BigUint r = c;
+    BigUint s = d;
+    int sense = 1;
+    BigUint left_quotient;
+    BigUint left_remainder;
+    BigUint right_quotient;
+    BigUint right_remainder;
+    for (size_t step = 0; step < CONTINUED_FRACTION_STEPS; ++step)
+    {
+        BigUint::divmod(left_quotient, left_remainder, p, q);
+        BigUint::divmod(right_quotient, right_remainder, r, s);
+        if (left_quotient != right_quotient)
+        {
+            return left_quotient < right_quotient ? -sense : sense;
+        }
+        if (left_remainder.is_zero() || right_remainder.is_zero())
+        {
+            if (left_remainder.is_zero() && right_remainder.is_zero())
+            {
+                return 0;
+            }
+            return left_remainder.is_zero() ? -sense : sense;
+        }
+        p = std::move(q);
+        q = std::move(left_remainder);
+        r = std::move(s);
+        s = std::move(right_remainder);
+        sense = -sense;
+    }
+    return sense * compare_products(p, s, r, q);
+}
+
+uint64_t BigRational::leading_bits(const BigUint& number, const size_t shift)
+{
+    const size_t index = shift / 64;
+    const size_t offset = shift % 64;
+    uint64_t res = number._number[index] >> offset;
+    if (offset != 0 && index + 1 < number._number.size())
+    {
+        res |= number._number[index + 1] << (64 - offset);
+    }
+    return res & (UINT64_MAX >> (64 - LEADING_BITS));
+}
+
+void BigRational::normalize()
+{
+    switch (normalization_mode.load(std::memory_order_relaxed))
+    {
+    case Normalization::Mode::ALWAYS:
+        minimize();
+        break;
+    case Normalization::Mode::LAZY:
+        if (bit_size() > _reduced_bits + normalization_growth_bits.load(std::memory_order_relaxed))
+        {
+            minimize();
+        }
+        break;
+    case Normalization::Mode::NEVER:
+        break;
+    }
+}
+
+void BigRational::set_zero()
+{
+    _numerator = 0;
+    _denominator = 1;
+    _reduced_bits = bit_size();
+}
+
+size_t BigRational::bit_size() const
+{
+    return _numerator.abs().bit_width() + _denominator.bit_width();
 }
\ No newline at end of file
@@ -10,30 +10,106 @@
 #include <ios>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <ranges>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
+#include "BarrettReducer.hpp"
+#include "Instrumentation.hpp"
+#include "MontgomeryContext.hpp"
 #include "big_int.h"
+#include "limbs.hpp"
 
-union Uint128 final
+static constexpr uint64_t BITS_IN_UINT64 = 64;
+static constexpr size_t BITS_IN_DECIMAL_CHUNK = 63;
+static constexpr size_t RADIX_DC_THRESHOLD = 30;
+
+// powers[k] = 10^(19 * 2^k), shared by every conversion and only ever extended.
+static std::shared_ptr<const std::vector<BigUint>> decimal_powers(const size_t count)
 {
-    __uint128_t number;
-    std::array<uint64_t, sizeof(__uint128_t) / sizeof(uint64_t)> parts;
-};
+    static std::mutex mutex;
+    static std::shared_ptr<const std::vector<BigUint>> cached =
+        std::make_shared<const std::vector<BigUint>>(1, BigUint(limbs::DECIMAL_CHUNK));
 
-static constexpr uint64_t BITS_IN_UINT64 = 64;
+    const std::lock_guard lock(mutex);
+    if (cached->size() >= count)
+    {
+        return cached;
+    }
+
+    auto powers = std::make_shared<std::vector<BigUint>>(*cached);
+    while (powers->size() < count)
+    {
+        powers->push_back(powers->back() * powers->back());
+    }
+    cached = std::move(powers);
+    return cached;
+}
+
+static uint32_t digit_value(const char digit)
+{
+    if (digit >= '0' && digit <= '9')
+    {
+        return digit - '0';
+    }
+    if (digit >= 'a' && digit <= 'f')
+    {
+        return digit - 'a' + 10;
+    }
+    if (digit >= 'A' && digit <= 'F')
+    {
+        return digit - 'A' + 10;
+    }
+    return std::numeric_limits<uint32_t>::max();
+}
+
+// Roughly how many limbs a run of digits in base parses into.
+static size_t parsed_limbs(const size_t digits, const BigUint::Base base)
+{
+    switch (base)
+    {
+    case BigUint::Base::HEXADECIMAL:
+        return (4 * digits + BITS_IN_UINT64 - 1) / BITS_IN_UINT64;
+    case BigUint::Base::OCTAL:
+        return (3 * digits + BITS_IN_UINT64 - 1) / BITS_IN_UINT64;
+    default:
+        return (digits + limbs::DECIMAL_CHUNK_DIGITS - 1) / limbs::DECIMAL_CHUNK_DIGITS;
+    }
+}
+
+static BigUint::Base stream_base(const std::ios_base& stream)
+{
+    const std::ios_base::fmtflags base_flag = stream.flags() & std::ios_base::basefield;
+    return base_flag == std::ios_base::hex   ? BigUint::Base::HEXADECIMAL
+           : base_flag == std::ios_base::oct ? BigUint::Base::OCTAL
+                                             : BigUint::Base::DECIMAL;
+}
+
+static void append_decimal_chunk(std::string& res, uint64_t chunk)
+{
+    std::array<char, limbs::DECIMAL_CHUNK_DIGITS> digits{};
+    for (size_t i = digits.size(); i-- > 0; chunk /= 10)
+    {
+        digits[i] = static_cast<char>('0' + chunk % 10);
+    }
+    res.append(digits.data(), digits.size());
+}
 
 BigUint::BigUint(uint64_t num) : _number(1, num) {}
 
 BigUint& BigUint::operator+=(const BigUint& other) &
 {
+    const instrumentation::Scope scope(instrumentation::Operation::ADD, std::max(_number.size(), other._number.size()));
     if (other._number.size() > _number.size())
     {
-        _number.resize(_number.size(), 0);
+        _number.resize(other._number.size(), 0);
     }
 
     const bool overflowed = big_int_add(_number.data(), _number.size(), other._number.data(), other._number.size());
@@ -47,6 +123,7 @@ BigUint& BigUint::operator+=(const BigUint& other) &
 
 BigUint& BigUint::operator-=(const BigUint& other) &
 {
+    const instrumentation::Scope scope(instrumentation::Operation::SUB, _number.size());
     if (other._number.size() > _number.size())
     {
         throw std::underflow_error("BigUint underflow in subtract, consider using BigInt");
@@ -64,13 +141,14 @@ BigUint& BigUint::operator-=(const BigUint& other) &
 
 BigUint& BigUint::operator>>=(const size_t bits) &
 {
+    const instrumentation::Scope scope(instrumentation::Operation::SHIFT_RIGHT, _number.size());
     if (bits == 0)
     {
         return *this;
     }
 
     const size_t uint64_counts = bits / BITS_IN_UINT64;
-    const size_t remainder_bits = bits % BITS_IN_UINT64;
+    const uint32_t remainder_bits = bits % BITS_IN_UINT64;
 
     if (uint64_counts >= _number.size())
     {
@@ -78,157 +156,343 @@ BigUint& BigUint::operator>>=(const size_t bits) &
         return *this;
     }
 
-    std::memmove(_number.data(), &_number[uint64_counts], (_number.size() - uint64_counts) * sizeof(uint64_t));
-
-    _number.resize(_number.size() - uint64_counts);
-
-    const size_t non_mask_bits = BITS_IN_UINT64 - remainder_bits;
-    const uint64_t mask = std::numeric_limits<uint64_t>::max() << non_mask_bits >> non_mask_bits;
-
-    uint64_t previous_remainder = 0;
-    for (uint64_t& num : std::ranges::reverse_view(_number))
+    const size_t size = _number.size() - uint64_counts;
+    if (remainder_bits == 0)
     {
-        const uint64_t remainder = num & mask;
-        num >>= bits;
-        num |= previous_remainder << non_mask_bits;
-        previous_remainder = remainder;
+        std::memmove(_number.data(), &_number[uint64_counts], size * sizeof(uint64_t));
     }
-
-    if (_number.back() == 0 && _number.size() >= 1)
+    else
     {
-        _number.pop_back();
+        limbs::rshift(_number.data(), &_number[uint64_counts], size, remainder_bits);
     }
 
+    _number.resize(size);
+    fix_size();
     return *this;
 }
 
 BigUint& BigUint::operator<<=(const size_t bits) &
 {
-    if (bits == 0)
+    const instrumentation::Scope scope(instrumentation::Operation::SHIFT_LEFT, _number.size());
+    if (bits == 0 || is_zero())
     {
         return *this;
     }
 
     const size_t uint64_counts = bits / BITS_IN_UINT64;
-    const size_t remainder_bits = bits % BITS_IN_UINT64;
-
-    _number.resize(_number.size() + uint64_counts);
-
-    std::memmove(&_number[uint64_counts], _number.data(), _number.size() * sizeof(uint64_t));
-    std::memset(_number.data(), 0, uint64_counts * sizeof(uint64_t));
-
-    const size_t non_mask_bits = BITS_IN_UINT64 - remainder_bits;
-    const uint64_t mask = std::numeric_limits<uint64_t>::max() >> non_mask_bits << non_mask_bits;
+    const uint32_t remainder_bits = bits % BITS_IN_UINT64;
+    const size_t size = _number.size();
 
-    uint64_t previous_remainder = 0;
-    for (uint64_t& num : _number)
+    _number.resize(size + uint64_counts + 1);
+    if (remainder_bits == 0)
     {
-        const uint64_t remainder = num & mask;
-        num <<= bits;
-        num |= previous_remainder >> non_mask_bits;
-        previous_remainder = remainder;
+        std::memmove(&_number[uint64_counts], _number.data(), size * sizeof(uint64_t));
+        _number.back() = 0;
     }
-
-    if (previous_remainder != 0)
+    else
     {
-        _number.push_back(previous_remainder >> non_mask_bits);
+        _number.back() = limbs::lshift(&_number[uint64_counts], _number.data(), size, remainder_bits);
     }
+    std::memset(_number.data(), 0, uint64_counts * sizeof(uint64_t));
 
+    fix_size();
     return *this;
 }
 
 BigUint& BigUint::operator*=(const BigUint& other) &
 {
-    return operator=(std::move(*this * other));
+    mul(*this, *this, other);
+    return *this;
 }
 
 BigUint& BigUint::operator*=(uint64_t number) &
 {
-    return operator=(std::move(*this * number));
+    const instrumentation::Scope scope(instrumentation::Operation::MUL, _number.size());
+    const uint64_t carry = big_int_mul_1(_number.data(), _number.data(), _number.size(), number);
+    if (carry != 0)
+    {
+        _number.push_back(carry);
+    }
+    else
+    {
+        fix_size();
+    }
+    return *this;
 }
 
 BigUint& BigUint::operator/=(const BigUint& other) &
 {
-    return operator=(div_and_mod(other).first);
+    BigUint remainder;
+    divmod(*this, remainder, *this, other);
+    return *this;
 }
 
 BigUint& BigUint::operator%=(const BigUint& other) &
 {
-    return operator=(div_and_mod(other).second);
+    BigUint quotient;
+    divmod(quotient, *this, *this, other);
+    return *this;
+}
+
+BigUint& BigUint::operator/=(uint64_t number) &
+{
+    const instrumentation::Scope scope(instrumentation::Operation::DIV_AND_MOD, _number.size());
+    if (number == 0)
+    {
+        throw std::invalid_argument("Division by zero is undefined");
+    }
+    instrumentation::record_tier(instrumentation::Tier::DIV_LIMB);
+
+    limbs::div_1(_number.data(), _number.data(), _number.size(), number);
+    fix_size();
+    return *this;
 }
 
-BigUint BigUint::operator+(const BigUint& other) const
+BigUint& BigUint::operator%=(uint64_t number) &
+{
+    return operator=(*this % number);
+}
+
+BigUint BigUint::operator+(const BigUint& other) const&
 {
     BigUint temp(*this);
     temp += other;
     return temp;
 }
 
-BigUint BigUint::operator-(const BigUint& other) const
+BigUint BigUint::operator-(const BigUint& other) const&
 {
     BigUint temp(*this);
     temp -= other;
     return temp;
 }
 
-BigUint BigUint::operator>>(size_t bits) const
+BigUint BigUint::operator>>(size_t bits) const&
 {
     BigUint temp(*this);
     temp >>= bits;
     return temp;
 }
 
-BigUint BigUint::operator<<(size_t bits) const
+BigUint BigUint::operator<<(size_t bits) const&
 {
     BigUint temp(*this);
     temp <<= bits;
     return temp;
 }
 
-BigUint BigUint::operator*(const BigUint& other) const
+BigUint BigUint::operator*(const BigUint& other) const&
 {
     BigUint res;
-    res._number.resize(_number.size() + other._number.size(), 0);
+    mul(res, *this, other);
+    return res;
+}
 
-    for (size_t i = 0; i < _number.size(); ++i)
+BigUint BigUint::operator*(uint64_t number) const&
+{
+    BigUint res;
+    res._number.resize(_number.size() + 1);
+    res._number.back() = big_int_mul_1(res._number.data(), _number.data(), _number.size(), number);
+    res.fix_size();
+    return res;
+}
+
+BigUint BigUint::operator/(const BigUint& other) const&
+{
+    return div_and_mod(other).first;
+}
+
+BigUint BigUint::operator%(const BigUint& other) const&
+{
+    return div_and_mod(other).second;
+}
+
+BigUint BigUint::operator/(uint64_t number) const&
+{
+    return div_and_mod(number).first;
+}
+
+BigUint BigUint::operator+(const BigUint& other) &&
+{
+    *this += other;
+    return std::move(*this);
+}
+
+BigUint BigUint::operator-(const BigUint& other) &&
+{
+    *this -= other;
+    return std::move(*this);
+}
+
+BigUint BigUint::operator>>(size_t bits) &&
+{
+    *this >>= bits;
+    return std::move(*this);
+}
+
+BigUint BigUint::operator<<(size_t bits) &&
+{
+    *this <<= bits;
+    return std::move(*this);
+}
+
+BigUint BigUint::operator*(const BigUint& other) &&
+{
+    *this *= other;
+    return std::move(*this);
+}
+
+BigUint BigUint::operator*(uint64_t number) &&
+{
+    *this *= number;
+    return std::move(*this);
+}
+
+BigUint BigUint::operator/(const BigUint& other) &&
+{
+    *this /= other;
+    return std::move(*this);
+}
+
+BigUint BigUint::operator%(const BigUint& other) &&
+{
+    *this %= other;
+    return std::move(*this);
+}
+
+BigUint BigUint::operator/(uint64_t number) &&
+{
+    *this /= number;
+    return std::move(*this);
+}
+
+uint64_t BigUint::operator%(uint64_t number) const&
+{
+    const instrumentation::Scope scope(instrumentation::Operation::DIV_AND_MOD, _number.size());
+    if (number == 0)
     {
-        const BigUint mul = other * _number[i];
-        big_int_add(&res._number[i], res._number.size() - i, mul._number.data(), mul._number.size());
+        throw std::invalid_argument("Division by zero is undefined");
     }
+    instrumentation::record_tier(instrumentation::Tier::DIV_LIMB);
 
-    res.fix_size();
-    return res;
+    return limbs::mod_1(_number.data(), _number.size(), number);
 }
 
-BigUint BigUint::operator*(uint64_t number) const
+// Only here so that rvalue % number is not ambiguous with the BigUint && overload.
+uint64_t BigUint::operator%(uint64_t number) &&
 {
-    BigUint low_part;
-    BigUint high_part;
-    const size_t size = _number.size();
+    return std::as_const(*this) % number;
+}
 
-    low_part._number.resize(size, 0);
-    high_part._number.resize(size + 1, 0);
+void BigUint::add(BigUint& dest, const BigUint& a, const BigUint& b)
+{
+    if (&dest == &b)
+    {
+        dest += a;
+        return;
+    }
 
-#pragma omp parallel for shared(size, low_part, high_part, number) default(none)
-    for (uint64_t i = 0; i < size; ++i)
+    dest = a;
+    dest += b;
+}
+
+void BigUint::sub(BigUint& dest, const BigUint& a, const BigUint& b)
+{
+    if (&dest == &b && &dest != &a)
     {
-        Uint128 mul{.number = static_cast<__uint128_t>(_number[i]) * number};
-        low_part._number[i] = mul.parts[0];
-        high_part._number[i + 1] = mul.parts[1];
+        BigUint temp(a);
+        temp -= b;
+        dest = std::move(temp);
+        return;
     }
 
-    high_part += low_part;
-    return high_part;
+    dest = a;
+    dest -= b;
 }
 
-BigUint BigUint::operator/(const BigUint& other) const
+void BigUint::mul(BigUint& dest, const BigUint& a, const BigUint& b)
 {
-    return div_and_mod(other).first;
+    const instrumentation::Scope scope(instrumentation::Operation::MUL, std::max(a._number.size(), b._number.size()));
+    const size_t size = a._number.size() + b._number.size();
+    if (&dest != &a && &dest != &b)
+    {
+        dest._number.resize_for_overwrite(size);
+        limbs::mul(dest._number.data(), a._number.data(), a._number.size(), b._number.data(), b._number.size());
+        dest.fix_size();
+        return;
+    }
+
+    limbs::ScratchArena arena;
+    uint64_t* const product = arena.allocate(size);
+    limbs::mul(product, a._number.data(), a._number.size(), b._number.data(), b._number.size());
+    dest._number.resize_for_overwrite(size);
+    std::memcpy(dest._number.data(), product, size * sizeof(uint64_t));
+    dest.fix_size();
 }
 
-BigUint BigUint::operator%(const BigUint& other) const
+void BigUint::sqr(BigUint& dest, const BigUint& a)
 {
-    return div_and_mod(other).second;
+    const instrumentation::Scope scope(instrumentation::Operation::SQR, a._number.size());
+    const size_t size = 2 * a._number.size();
+    if (&dest != &a)
+    {
+        dest._number.resize_for_overwrite(size);
+        limbs::sqr(dest._number.data(), a._number.data(), a._number.size());
+        dest.fix_size();
+        return;
+    }
+
+    limbs::ScratchArena arena;
+    uint64_t* const square = arena.allocate(size);
+    limbs::sqr(square, a._number.data(), a._number.size());
+    dest._number.resize_for_overwrite(size);
+    std::memcpy(dest._number.data(), square, size * sizeof(uint64_t));
+    dest.fix_size();
+}
+
+void BigUint::divmod(BigUint& quotient, BigUint& remainder, const BigUint& a, const BigUint& b)
+{
+    const instrumentation::Scope scope(instrumentation::Operation::DIV_AND_MOD, a._number.size());
+    if (&quotient == &remainder)
+    {
+        throw std::invalid_argument("Quotient and remainder must be distinct");
+    }
+    if (b.is_zero())
+    {
+        throw std::invalid_argument("Division by zero is undefined");
+    }
+
+    if (a < b)
+    {
+        remainder = a;
+        quotient = 0;
+        return;
+    }
+
+    if (b.is_power_of2())
+    {
+        const size_t shift = b.bit_width() - 1;
+        BigUint low = a.get_n_bits(0, shift);
+        quotient = a;
+        quotient >>= shift;
+        remainder = std::move(low);
+        return;
+    }
+
+    const size_t a_size = a._number.size();
+    const size_t b_size = b._number.size();
+    const size_t quotient_size = a_size - b_size + 1;
+    limbs::ScratchArena arena;
+    uint64_t* const quotient_limbs = arena.allocate(quotient_size + b_size);
+    uint64_t* const remainder_limbs = quotient_limbs + quotient_size;
+    limbs::divrem(quotient_limbs, remainder_limbs, a._number.data(), a_size, b._number.data(), b_size);
+
+    quotient._number.resize_for_overwrite(quotient_size);
+    std::memcpy(quotient._number.data(), quotient_limbs, quotient_size * sizeof(uint64_t));
+    quotient.fix_size();
+    remainder._number.resize_for_overwrite(b_size);
+    std::memcpy(remainder._number.data(), remainder_limbs, b_size * sizeof(uint64_t));
+    remainder.fix_size();
 }
 
 bool BigUint::is_zero() const
@@ -260,90 +524,118 @@ size_t BigUint::bit_width() const
 
 BigUint BigUint::get_n_bits(const size_t begin, const size_t end_excluding) const
 {
-    if (begin == end_excluding)
+    const size_t first = begin / BITS_IN_UINT64;
+    const size_t last = (end_excluding - 1) / BITS_IN_UINT64;
+    if (begin >= end_excluding || first >= _number.size())
     {
         return 0;
     }
 
     BigUint res;
-    res._number.resize((end_excluding - 1) / BITS_IN_UINT64 + 1, 0);
-    std::memcpy(&res._number[begin / BITS_IN_UINT64], &_number[begin / BITS_IN_UINT64],
-                ((end_excluding - 1) / BITS_IN_UINT64 - begin / BITS_IN_UINT64 + 1) * sizeof(uint64_t));
-
-    const size_t remainder_low_bits = begin % BITS_IN_UINT64;
-    const size_t remainder_high_bits = BITS_IN_UINT64 - end_excluding % BITS_IN_UINT64;
-    res._number[begin / BITS_IN_UINT64] &= std::numeric_limits<uint64_t>::max() << remainder_low_bits;
-    res._number[(end_excluding - 1) / BITS_IN_UINT64] &= std::numeric_limits<uint64_t>::max() >> remainder_high_bits;
+    const size_t copied_last = std::min(last, _number.size() - 1);
+    res._number.resize(copied_last + 1, 0);
+    std::memcpy(&res._number[first], &_number[first], (copied_last - first + 1) * sizeof(uint64_t));
+
+    res._number[first] &= std::numeric_limits<uint64_t>::max() << (begin % BITS_IN_UINT64);
+    if (copied_last == last && end_excluding % BITS_IN_UINT64 != 0)
+    {
+        res._number[last] &= std::numeric_limits<uint64_t>::max() >> (BITS_IN_UINT64 - end_excluding % BITS_IN_UINT64);
+    }
+
+    res.fix_size();
     return res;
 }
 
 std::pair<BigUint, BigUint> BigUint::div_and_mod(const BigUint& other) const
 {
-    const size_t first_non_zero = other.bit_width() - 1;
-    if (first_non_zero == std::numeric_limits<size_t>::max())
-    {
-        throw std::invalid_argument("Division by zero is undefined");
-    }
+    std::pair<BigUint, BigUint> res;
+    divmod(res.first, res.second, *this, other);
+    return res;
+}
 
-    if (other.is_power_of2())
+std::pair<BigUint, uint64_t> BigUint::div_and_mod(uint64_t number) const
+{
+    const instrumentation::Scope scope(instrumentation::Operation::DIV_AND_MOD, _number.size());
+    if (number == 0)
     {
-        return {operator>>(first_non_zero), get_n_bits(0, first_non_zero)};
+        throw std::invalid_argument("Division by zero is undefined");
     }
+    instrumentation::record_tier(instrumentation::Tier::DIV_LIMB);
 
-    BigUint mod(*this);
     BigUint div;
-    div._number.resize(_number.size(), 0);
-    while (other <= mod)
-    {
-        const size_t bits = mod.bit_width() - 1 - first_non_zero;
-        size_t uint64_counts = bits / BITS_IN_UINT64;
-        size_t remainder_bits = bits % BITS_IN_UINT64;
-
-        BigUint sub(other << remainder_bits);
-        if (mod.less_than_shifted(sub, uint64_counts))
-        {
-            if (remainder_bits == 0)
-            {
-                --uint64_counts;
-                remainder_bits = BITS_IN_UINT64 - 1;
-                sub <<= remainder_bits;
-            }
-            else
-            {
-                --remainder_bits;
-                sub >>= 1;
-            }
-        }
-
-        big_int_sub(&mod._number[uint64_counts], mod._number.size() - uint64_counts, sub._number.data(),
-                    sub._number.size());
-        mod.fix_size();
-
-        div._number[uint64_counts] |= 1UL << remainder_bits;
-    }
-
+    div._number.resize(_number.size());
+    const uint64_t mod = limbs::div_1(div._number.data(), _number.data(), _number.size(), number);
     div.fix_size();
 
-    return {div, mod};
+    return {std::move(div), mod};
 }
 
-BigUint BigUint::gcd(const BigUint& other) const
+BigUint BigUint::lcm(const BigUint& other) const
 {
-    auto [larger, smaller] =
-        *this < other ? std::pair<BigUint, BigUint>{other, *this} : std::pair<BigUint, BigUint>{*this, other};
+    return *this * other / gcd(other);
+}
 
-    while (!smaller.is_zero())
+BigUint BigUint::square() const
+{
+    BigUint res;
+    sqr(res, *this);
+    return res;
+}
+
+// Left to right over the exponent bits, alternating between two buffers so no step copies or reallocates.
+BigUint BigUint::pow(const uint64_t exponent) const
+{
+    if (exponent == 0)
     {
-        larger %= smaller;
-        smaller._number.swap(larger._number);
+        return 1;
+    }
+    if (is_power_of2())
+    {
+        return BigUint(1) << ((bit_width() - 1) * exponent);
     }
 
-    return larger;
+    BigUint res = *this;
+    BigUint next;
+    for (int bit = std::bit_width(exponent) - 2; bit >= 0; --bit)
+    {
+        sqr(next, res);
+        res._number.swap(next._number);
+        if (((exponent >> bit) & 1) != 0)
+        {
+            mul(next, res, *this);
+            res._number.swap(next._number);
+        }
+    }
+    return res;
 }
 
-BigUint BigUint::lcm(const BigUint& other) const
+BigUint BigUint::pow_mod(const BigUint& base, const BigUint& exp, const BigUint& mod)
 {
-    return *this * other / gcd(other);
+    if (mod.is_zero())
+    {
+        throw std::invalid_argument("Division by zero is undefined");
+    }
+    if ((mod._number[0] & 1) != 0)
+    {
+        return MontgomeryContext(mod).pow(base, exp);
+    }
+
+    const BarrettReducer reducer(mod);
+    BigUint res = reducer.reduce(BigUint(1));
+    BigUint power = reducer.reduce(base);
+    const size_t exp_bits = exp.bit_width();
+    for (size_t bit = 0; bit < exp_bits; ++bit)
+    {
+        if (((exp._number[bit / BITS_IN_UINT64] >> (bit % BITS_IN_UINT64)) & 1) != 0)
+        {
+            res = reducer.mulmod(res, power);
+        }
+        if (bit + 1 < exp_bits)
+        {
+            power = reducer.mulmod(power, power);
+        }
+    }
+    return res;
 }
 
 bool BigUint::operator==(const BigUint& other) const
@@ -402,6 +694,7 @@ bool BigUint::operator<=(const BigUint& other) const
 
 std::string BigUint::to_string(const Base base) const
 {
+    const instrumentation::Scope scope(instrumentation::Operation::TO_STRING, _number.size());
     std::ostringstream oss;
 
     switch (base)
@@ -410,53 +703,289 @@ std::string BigUint::to_string(const Base base) const
     {
         auto iter = _number.crbegin();
         static constexpr uint32_t HEX_CHARACTERS_IN_UINT64 = sizeof(uint64_t) * 2;
-        oss << std::hex << *iter << std::setfill('0') << std::setw(HEX_CHARACTERS_IN_UINT64);
+        oss << std::hex << *iter << std::setfill('0');
         while (++iter != _number.crend())
         {
-            oss << *iter;
+            oss << std::setw(HEX_CHARACTERS_IN_UINT64) << *iter;
         }
         return oss.str();
     }
+    case Base::OCTAL:
+    {
+        static constexpr uint32_t BITS_IN_OCTAL_DIGIT = 3;
+        const size_t digits = std::max<size_t>(1, (bit_width() + BITS_IN_OCTAL_DIGIT - 1) / BITS_IN_OCTAL_DIGIT);
+        std::string res(digits, '0');
+        for (size_t i = 0; i < digits; ++i)
+        {
+            const size_t limb = i * BITS_IN_OCTAL_DIGIT / BITS_IN_UINT64;
+            const uint32_t offset = i * BITS_IN_OCTAL_DIGIT % BITS_IN_UINT64;
+            uint64_t value = _number[limb] >> offset;
+            if (offset + BITS_IN_OCTAL_DIGIT > BITS_IN_UINT64 && limb + 1 < _number.size())
+            {
+                value |= _number[limb + 1] << (BITS_IN_UINT64 - offset);
+            }
+            res[digits - 1 - i] = static_cast<char>('0' + (value & 7));
+        }
+        return res;
+    }
     default:
     {
-        oss << std::hex;
-        const BigUint ten_of_base = static_cast<uint8_t>(base);
-        BigUint remainder(*this);
-        while (remainder._number.size() > 1)
+        size_t levels = 0;
+        while ((BITS_IN_DECIMAL_CHUNK << levels) < bit_width())
+        {
+            ++levels;
+        }
+
+        std::string res;
+        if (_number.size() < RADIX_DC_THRESHOLD)
+        {
+            instrumentation::record_tier(instrumentation::Tier::RADIX_BASECASE);
+            append_decimal_basecase(res, 0);
+        }
+        else
         {
-            auto [div, mod] = remainder.div_and_mod(ten_of_base);
-            remainder = std::move(div);
-            oss << mod._number[0];
+            instrumentation::record_tier(instrumentation::Tier::RADIX_DIVIDE_AND_CONQUER);
+            append_decimal(res, *decimal_powers(levels), levels, 0);
         }
-        std::string easy_calc = std::to_string(remainder._number[0]);
-        std::reverse(easy_calc.begin(), easy_calc.end());
-        oss << easy_calc;
-        std::string res = oss.str();
-        std::reverse(res.begin(), res.end());
         return res;
     }
     }
 }
 
+BigUint BigUint::from_string(const std::string_view str, const Base base)
+{
+    BigUint res;
+    const std::from_chars_result result = from_chars(str.data(), str.data() + str.size(), res, base);
+    if (result.ec != std::errc() || result.ptr != str.data() + str.size())
+    {
+        throw std::invalid_argument("Invalid BigUint string");
+    }
+    return res;
+}
+
+std::from_chars_result BigUint::from_chars(const char* first, const char* last, BigUint& value, const Base base)
+{
+    const uint32_t radix = static_cast<uint8_t>(base);
+    const char* end = first;
+    while (end != last && digit_value(*end) < radix)
+    {
+        ++end;
+    }
+    const instrumentation::Scope scope(instrumentation::Operation::FROM_STRING, parsed_limbs(end - first, base));
+    if (end == first)
+    {
+        return {first, std::errc::invalid_argument};
+    }
+
+    switch (base)
+    {
+    case Base::HEXADECIMAL:
+        value = from_bits(first, end, 4);
+        break;
+    case Base::OCTAL:
+        value = from_bits(first, end, 3);
+        break;
+    default:
+    {
+        const size_t digits = end - first;
+        const size_t count = (digits + limbs::DECIMAL_CHUNK_DIGITS - 1) / limbs::DECIMAL_CHUNK_DIGITS;
+        LimbVector chunks(count, 0);
+        const char* iter = first;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const char* const chunk_end = end - (count - 1 - i) * limbs::DECIMAL_CHUNK_DIGITS;
+            for (; iter != chunk_end; ++iter)
+            {
+                chunks[i] = chunks[i] * 10 + digit_value(*iter);
+            }
+        }
+
+        size_t levels = 0;
+        while ((size_t{1} << levels) < count)
+        {
+            ++levels;
+        }
+        instrumentation::record_tier(count < RADIX_DC_THRESHOLD ? instrumentation::Tier::RADIX_BASECASE
+                                                                : instrumentation::Tier::RADIX_DIVIDE_AND_CONQUER);
+        value = from_decimal_chunks(chunks.data(), count, *decimal_powers(levels));
+        break;
+    }
+    }
+
+    return {end, std::errc()};
+}
+
+std::basic_istream<char>& operator>>(std::basic_istream<char>& stream, BigUint& num)
+{
+    const std::basic_istream<char>::sentry sentry(stream);
+    if (!sentry)
+    {
+        return stream;
+    }
+
+    const BigUint::Base base = stream_base(stream);
+    std::string digits;
+    for (int next = stream.peek(); next != std::char_traits<char>::eof() &&
+                                   digit_value(static_cast<char>(next)) < static_cast<uint8_t>(base);
+         next = stream.peek())
+    {
+        digits.push_back(static_cast<char>(stream.get()));
+    }
+
+    if (digits.empty())
+    {
+        stream.setstate(std::ios_base::failbit);
+        return stream;
+    }
+
+    num = BigUint::from_string(digits, base);
+    return stream;
+}
+
 std::basic_ostream<char>& operator<<(std::basic_ostream<char>& stream, const BigUint& num)
 {
-    const std::ios_base::fmtflags base_flag = stream.flags() & std::ios_base::basefield;
-    return stream << num.to_string(base_flag == std::ios_base::hex   ? BigUint::Base::HEXADECIMAL
-                                   : base_flag == std::ios_base::oct ? BigUint::Base::OCTAL
-                                                                     : BigUint::Base::DECIMAL);
+    return stream << num.to_string(stream_base(stream));
 }
 
-bool BigUint::less_than_shifted(const BigUint& other, const size_t shift_count)
+// Appends the digits of a number below powers[level]^2, left-padded to width digits when width is not zero.
+void BigUint::append_decimal(std::string& res, const std::vector<BigUint>& powers, const size_t level,
+                             const size_t width) const
 {
-    for (size_t i = _number.size() - 1; i < std::numeric_limits<size_t>::max(); --i)
+    if (level == 0 || _number.size() < RADIX_DC_THRESHOLD)
     {
-        if (_number[i] != other._number[i - shift_count])
+        append_decimal_basecase(res, width);
+        return;
+    }
+
+    const auto [high, low] = div_and_mod(powers[level - 1]);
+    const size_t half = limbs::DECIMAL_CHUNK_DIGITS << (level - 1);
+    if (width == 0 && high.is_zero())
+    {
+        low.append_decimal(res, powers, level - 1, 0);
+        return;
+    }
+
+    if (!limbs::parallel_worthwhile(_number.size()))
+    {
+        high.append_decimal(res, powers, level - 1, width == 0 ? 0 : width - half);
+        low.append_decimal(res, powers, level - 1, half);
+        return;
+    }
+
+    // The halves are independent once split; the low digits go to their own string and are appended afterwards.
+    std::string low_digits;
+    limbs::parallel_for(2, _number.size(),
+                        [&](const size_t index)
+                        {
+                            if (index == 0)
+                            {
+                                high.append_decimal(res, powers, level - 1, width == 0 ? 0 : width - half);
+                            }
+                            else
+                            {
+                                low.append_decimal(low_digits, powers, level - 1, half);
+                            }
+                        });
+    res += low_digits;
+}
+
+void BigUint::append_decimal_basecase(std::string& res, const size_t width) const
+{
+    static constexpr limbs::LimbDivisor divisor(limbs::DECIMAL_CHUNK);
+
+    LimbVector remainder(_number);
+    size_t size = remainder.size();
+    LimbVector chunks;
+    while (size > 1 || remainder[0] >= limbs::DECIMAL_CHUNK)
+    {
+        chunks.push_back(limbs::div_1(remainder.data(), remainder.data(), size, divisor));
+        size -= remainder[size - 1] == 0;
+    }
+
+    const std::string top = std::to_string(remainder[0]);
+    const size_t digits = top.size() + chunks.size() * limbs::DECIMAL_CHUNK_DIGITS;
+    if (width > digits)
+    {
+        res.append(width - digits, '0');
+    }
+    res += top;
+    for (auto iter = chunks.crbegin(); iter != chunks.crend(); ++iter)
+    {
+        append_decimal_chunk(res, *iter);
+    }
+}
+
+BigUint BigUint::from_bits(const char* first, const char* last, const uint32_t bits_per_digit)
+{
+    BigUint res;
+    res._number.assign(((last - first) * bits_per_digit + BITS_IN_UINT64 - 1) / BITS_IN_UINT64, 0);
+    size_t bit = 0;
+    for (const char* iter = last; iter-- != first; bit += bits_per_digit)
+    {
+        const uint64_t digit = digit_value(*iter);
+        const size_t limb = bit / BITS_IN_UINT64;
+        const uint32_t offset = bit % BITS_IN_UINT64;
+        res._number[limb] |= digit << offset;
+        if (offset + bits_per_digit > BITS_IN_UINT64)
         {
-            return _number[i] < other._number[i - shift_count];
+            res._number[limb + 1] |= digit >> (BITS_IN_UINT64 - offset);
         }
     }
 
-    return false;
+    res.fix_size();
+    return res;
+}
+
+// Chunks hold 19 decimal digits each, most significant first. The low 2^k chunks are converted separately and joined
+// with one multiplication by powers[k].
+BigUint BigUint::from_decimal_chunks(const uint64_t* chunks, const size_t count, const std::vector<BigUint>& powers)
+{
+    if (count < RADIX_DC_THRESHOLD)
+    {
+        BigUint res;
+        res._number.resize(count);
+        size_t size = 1;
+        res._number[0] = chunks[0];
+        for (size_t i = 1; i < count; ++i)
+        {
+            uint64_t carry = big_int_mul_1(res._number.data(), res._number.data(), size, limbs::DECIMAL_CHUNK);
+            carry += limbs::add_limb(res._number.data(), size, chunks[i]);
+            if (carry != 0)
+            {
+                res._number[size++] = carry;
+            }
+        }
+
+        res._number.resize(size);
+        res.fix_size();
+        return res;
+    }
+
+    size_t level = 0;
+    while ((size_t{2} << level) < count)
+    {
+        ++level;
+    }
+    const size_t low_count = size_t{1} << level;
+
+    BigUint high;
+    BigUint low;
+    limbs::parallel_for(2, count,
+                        [&](const size_t index)
+                        {
+                            if (index == 0)
+                            {
+                                high = from_decimal_chunks(chunks, count - low_count, powers);
+                            }
+                            else
+                            {
+                                low = from_decimal_chunks(chunks + count - low_count, low_count, powers);
+                            }
+                        });
+
+    BigUint res = high * powers[level];
+    res += low;
+    return res;
 }
 
 void BigUint::fix_size()
@@ -0,0 +1,115 @@
+#include "Instrumentation.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+struct AtomicOperationStats final
+{
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> nanoseconds;
+    std::atomic<uint64_t> allocations;
+    std::array<std::atomic<uint64_t>, instrumentation::SIZE_BUCKETS> sizes;
+};
+
+// Relaxed counters: a snapshot taken while other threads compute may see one call's fields partially updated.
+std::array<AtomicOperationStats, instrumentation::OPERATION_COUNT> operation_stats{};
+std::array<std::atomic<uint64_t>, instrumentation::TIER_COUNT> tier_counts{};
+std::atomic<uint64_t> allocation_count{0};
+
+thread_local uint64_t allocations_on_thread = 0;
+
+constexpr std::array<const char*, instrumentation::OPERATION_COUNT> OPERATION_NAMES = {
+    "add", "sub", "mul", "sqr", "div_and_mod", "gcd", "to_string", "from_string", "shift_left", "shift_right"};
+
+constexpr std::array<const char*, instrumentation::TIER_COUNT> TIER_NAMES = {
+    "mul_basecase", "mul_karatsuba", "mul_toom3", "mul_toom4", "mul_unbalanced", "mul_ntt", "sqr_basecase",
+    "sqr_karatsuba", "sqr_toom3", "sqr_toom4", "sqr_ntt", "div_limb", "div_schoolbook", "div_divide_and_conquer",
+    "div_newton", "gcd_lehmer", "gcd_half_gcd", "radix_basecase", "radix_divide_and_conquer"};
+} // namespace
+
+namespace instrumentation
+{
+Snapshot snapshot()
+{
+    Snapshot res;
+    for (size_t i = 0; i < OPERATION_COUNT; ++i)
+    {
+        const AtomicOperationStats& stats = operation_stats[i];
+        OperationStats& copy = res.operations[i];
+        copy.calls = stats.calls.load(std::memory_order_relaxed);
+        copy.nanoseconds = stats.nanoseconds.load(std::memory_order_relaxed);
+        copy.allocations = stats.allocations.load(std::memory_order_relaxed);
+        for (size_t bucket = 0; bucket < SIZE_BUCKETS; ++bucket)
+        {
+            copy.sizes[bucket] = stats.sizes[bucket].load(std::memory_order_relaxed);
+        }
+    }
+    for (size_t i = 0; i < TIER_COUNT; ++i)
+    {
+        res.tiers[i] = tier_counts[i].load(std::memory_order_relaxed);
+    }
+    res.allocations = allocation_count.load(std::memory_order_relaxed);
+    return res;
+}
+
+void reset()
+{
+    for (AtomicOperationStats& stats : operation_stats)
+    {
+        stats.calls.store(0, std::memory_order_relaxed);
+        stats.nanoseconds.store(0, std::memory_order_relaxed);
+        stats.allocations.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64_t>& bucket : stats.sizes)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (std::atomic<uint64_t>& count : tier_counts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+    allocation_count.store(0, std::memory_order_relaxed);
+}
+
+const char* name(const Operation operation)
+{
+    return OPERATION_NAMES[static_cast<size_t>(operation)];
+}
+
+const char* name(const Tier tier)
+{
+    return TIER_NAMES[static_cast<size_t>(tier)];
+}
+
+void record_operation(const Operation operation, const size_t limbs, const uint64_t nanoseconds,
+                      const uint64_t allocations)
+{
+    AtomicOperationStats& stats = operation_stats[static_cast<size_t>(operation)];
+    const size_t bucket = std::min<size_t>(SIZE_BUCKETS - 1, std::bit_width(std::max<size_t>(limbs, 1)) - 1);
+    stats.calls.fetch_add(1, std::memory_order_relaxed);
+    stats.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    stats.allocations.fetch_add(allocations, std::memory_order_relaxed);
+    stats.sizes[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void record_tier_slow(const Tier tier)
+{
+    tier_counts[static_cast<size_t>(tier)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void record_allocation_slow()
+{
+    ++allocations_on_thread;
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t thread_allocations()
+{
+    return allocations_on_thread;
+}
+} // namespace instrumentation
@@ -0,0 +1,147 @@
+#include "LimbVector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include "limbs.hpp"
+
+LimbVector::LimbVector(const size_t size, const uint64_t value)
+{
+    assign(size, value);
+}
+
+LimbVector::LimbVector(const std::initializer_list<uint64_t> values)
+{
+    reserve(values.size());
+    std::copy(values.begin(), values.end(), _data);
+    _size = values.size();
+}
+
+void LimbVector::reserve(const size_t capacity)
+{
+    if (capacity <= _capacity)
+    {
+        return;
+    }
+
+    uint64_t* const data = limbs::allocate(capacity);
+    std::memcpy(data, _data, _size * sizeof(uint64_t));
+    release();
+    _data = data;
+    _capacity = capacity;
+}
+
+void LimbVector::resize(const size_t size, const uint64_t value)
+{
+    if (size > _capacity)
+    {
+        reserve(std::max(size, 2 * _capacity));
+    }
+    if (size > _size)
+    {
+        std::fill(_data + _size, _data + size, value);
+    }
+    _size = size;
+}
+
+void LimbVector::assign(const size_t size, const uint64_t value)
+{
+    _size = 0;
+    reserve(size);
+    std::fill(_data, _data + size, value);
+    _size = size;
+}
+
+void LimbVector::resize_for_overwrite(const size_t size)
+{
+    _size = 0;
+    reserve(size);
+    _size = size;
+}
+
+void LimbVector::push_back(const uint64_t value)
+{
+    if (_size == _capacity)
+    {
+        reserve(2 * _capacity);
+    }
+    _data[_size++] = value;
+}
+
+void LimbVector::swap(LimbVector& other) noexcept
+{
+    LimbVector temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+}
+
+void LimbVector::release()
+{
+    if (!is_inline())
+    {
+        limbs::deallocate(_data, _capacity);
+    }
+    _data = _inline;
+    _capacity = INLINE_CAPACITY;
+}
+
+LimbVector::LimbVector(const LimbVector& other)
+{
+    reserve(other._size);
+    std::memcpy(_data, other._data, other._size * sizeof(uint64_t));
+    _size = other._size;
+}
+
+LimbVector& LimbVector::operator=(const LimbVector& other)
+{
+    if (this != &other)
+    {
+        _size = 0;
+        reserve(other._size);
+        std::memcpy(_data, other._data, other._size * sizeof(uint64_t));
+        _size = other._size;
+    }
+    return *this;
+}
+
+LimbVector::LimbVector(LimbVector&& other) noexcept
+{
+    if (other.is_inline())
+    {
+        std::memcpy(_inline, other._inline, other._size * sizeof(uint64_t));
+    }
+    else
+    {
+        _data = std::exchange(other._data, other._inline);
+        _capacity = std::exchange(other._capacity, INLINE_CAPACITY);
+    }
+    _size = std::exchange(other._size, 0);
+}
+
+LimbVector& LimbVector::operator=(LimbVector&& other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    if (other.is_inline())
+    {
+        std::memcpy(_data, other._inline, other._size * sizeof(uint64_t));
+    }
+    else
+    {
+        release();
+        _data = std::exchange(other._data, other._inline);
+        _capacity = std::exchange(other._capacity, INLINE_CAPACITY);
+    }
+    _size = std::exchange(other._size, 0);
+    return *this;
+}
+
+LimbVector::~LimbVector()
+{
+    release();
+}
@@ -0,0 +1,187 @@
+#include "MontgomeryContext.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "BigUint.hpp"
+#include "big_int.h"
+#include "limbs.hpp"
+
+namespace
+{
+inline constexpr size_t BITS_IN_UINT64 = 64;
+
+// Window width by exponent size, trading the 2^(width - 1) table entries against one multiplication per window.
+size_t window_width(const size_t exp_bits)
+{
+    return exp_bits > 671 ? 6 : exp_bits > 239 ? 5 : exp_bits > 79 ? 4 : exp_bits > 23 ? 3 : exp_bits > 7 ? 2 : 1;
+}
+
+bool test_bit(const LimbVector& number, const size_t bit)
+{
+    return ((number[bit / BITS_IN_UINT64] >> (bit % BITS_IN_UINT64)) & 1) != 0;
+}
+} // namespace
+
+MontgomeryContext::MontgomeryContext(BigUint modulus) : _modulus(std::move(modulus)), _inverse(0)
+{
+    if ((_modulus._number[0] & 1) == 0)
+    {
+        throw std::invalid_argument("Montgomery modulus must be odd");
+    }
+
+    // Newton's iteration doubles the correct low bits of m^-1 mod 2^64, and m is its own inverse mod 8.
+    const uint64_t low = _modulus._number[0];
+    uint64_t inverse = low;
+    for (int i = 0; i < 5; ++i)
+    {
+        inverse *= 2 - low * inverse;
+    }
+    _inverse = -inverse;
+
+    _r_squared = BigUint(1) << (2 * BITS_IN_UINT64 * limb_count());
+    _r_squared %= _modulus;
+}
+
+BigUint MontgomeryContext::to_montgomery(const BigUint& number) const
+{
+    return multiply(number < _modulus ? number : number % _modulus, _r_squared);
+}
+
+BigUint MontgomeryContext::from_montgomery(const BigUint& number) const
+{
+    const size_t size = limb_count();
+    limbs::ScratchArena arena;
+    uint64_t* const product = arena.allocate(3 * size);
+    uint64_t* const res = product + 2 * size;
+    load(product, number);
+    std::fill(product + size, product + 2 * size, 0);
+    reduce(res, product);
+    return store(res);
+}
+
+BigUint MontgomeryContext::multiply(const BigUint& a, const BigUint& b) const
+{
+    const size_t size = limb_count();
+    limbs::ScratchArena arena;
+    uint64_t* const a_limbs = arena.allocate(5 * size);
+    uint64_t* const b_limbs = a_limbs + size;
+    uint64_t* const product = b_limbs + size;
+    uint64_t* const res = product + 2 * size;
+    load(a_limbs, a);
+    load(b_limbs, b);
+    mul(res, a_limbs, b_limbs, product);
+    return store(res);
+}
+
+BigUint MontgomeryContext::pow(const BigUint& base, const BigUint& exp) const
+{
+    if (exp.is_zero())
+    {
+        return _modulus == BigUint(1) ? BigUint(0) : BigUint(1);
+    }
+
+    const size_t size = limb_count();
+    const size_t exp_bits = exp.bit_width();
+    const size_t width = window_width(exp_bits);
+    const size_t table_size = size_t{1} << (width - 1);
+    const BigUint base_montgomery = to_montgomery(base);
+
+    limbs::ScratchArena arena;
+    uint64_t* const table = arena.allocate((table_size + 4) * size);
+    uint64_t* const square = table + table_size * size;
+    uint64_t* const res = square + size;
+    uint64_t* const product = res + size;
+
+    // table[i] = base^(2 i + 1)
+    load(table, base_montgomery);
+    if (table_size > 1)
+    {
+        mul(square, table, table, product);
+        for (size_t i = 1; i < table_size; ++i)
+        {
+            mul(table + i * size, table + (i - 1) * size, square, product);
+        }
+    }
+
+    const LimbVector& exp_limbs = exp._number;
+    bool started = false;
+    for (size_t bit = exp_bits; bit-- > 0;)
+    {
+        if (!test_bit(exp_limbs, bit))
+        {
+            mul(res, res, res, product);
+            continue;
+        }
+
+        // The longest window of at most width bits starting at bit and ending in a one.
+        size_t last = bit + 1 > width ? bit + 1 - width : 0;
+        while (!test_bit(exp_limbs, last))
+        {
+            ++last;
+        }
+        size_t window = 0;
+        for (size_t i = bit + 1; i-- > last;)
+        {
+            window = (window << 1) | static_cast<size_t>(test_bit(exp_limbs, i));
+        }
+
+        const uint64_t* const power = table + (window >> 1) * size;
+        if (started)
+        {
+            for (size_t i = last; i <= bit; ++i)
+            {
+                mul(res, res, res, product);
+            }
+            mul(res, res, power, product);
+        }
+        else
+        {
+            std::copy(power, power + size, res);
+            started = true;
+        }
+        bit = last;
+    }
+
+    std::copy(res, res + size, product);
+    std::fill(product + size, product + 2 * size, 0);
+    reduce(res, product);
+    return store(res);
+}
+
+void MontgomeryContext::load(uint64_t* res, const BigUint& number) const
+{
+    const size_t size = number._number.size();
+    std::copy(number._number.begin(), number._number.end(), res);
+    std::fill(res + size, res + limb_count(), 0);
+}
+
+BigUint MontgomeryContext::store(const uint64_t* number) const
+{
+    BigUint res;
+    res._number.resize_for_overwrite(limb_count());
+    std::copy(number, number + limb_count(), res._number.data());
+    res.fix_size();
+    return res;
+}
+
+// res = a b / R mod m; res may alias a or b, product is 2 n limbs of scratch.
+void MontgomeryContext::mul(uint64_t* res, const uint64_t* a, const uint64_t* b, uint64_t* product) const
+{
+    const size_t size = limb_count();
+    limbs::mul(product, a, size, b, size);
+    reduce(res, product);
+}
+
+// res = product / R mod m for product < m R; product is clobbered.
+void MontgomeryContext::reduce(uint64_t* res, uint64_t* product) const
+{
+    const size_t size = limb_count();
+    const uint64_t* const modulus = _modulus._number.data();
+    const uint64_t carry = big_int_redc_1(res, product, modulus, size, _inverse);
+    if (carry != 0 || limbs::cmp(res, modulus, size) >= 0)
+    {
+        big_int_sub(res, size, modulus, size);
+    }
+}
@@ -0,0 +1,27 @@
+#include "NttMultiplier.hpp"
+#include <cstddef>
+#include <utility>
+#include "BigUint.hpp"
+#include "limbs.hpp"
+
+NttMultiplier::NttMultiplier(BigUint operand, const size_t max_other_size)
+    : _operand(std::move(operand)), _max_other_size(max_other_size == 0 ? _operand._number.size() : max_other_size)
+{
+    const size_t size = _operand._number.size();
+    limbs::ntt_forward(_transform, _operand._number.data(), size, limbs::ntt_length(size + _max_other_size));
+}
+
+BigUint NttMultiplier::multiply(const BigUint& other) const
+{
+    const size_t other_size = other._number.size();
+    if (other_size > _max_other_size || other_size < limbs::NTT_THRESHOLD / 4)
+    {
+        return _operand * other;
+    }
+
+    BigUint res;
+    res._number.resize(_operand._number.size() + other_size);
+    limbs::ntt_mul(res._number.data(), _transform, other._number.data(), other_size);
+    res.fix_size();
+    return res;
+}
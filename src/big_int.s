@@ -43,4 +43,318 @@ __end_sub_carry_loop:
     setc %al
     ret
 
+.globl big_int_mul_1_baseline
+big_int_mul_1_baseline:
+    mov %rdx, %r8
+    xor %r9d, %r9d
+    test %r8, %r8
+    jz __end_mul_1
+__loop_mul_1:
+    mov (%rsi), %rax
+    mul %rcx
+    add %r9, %rax
+    adc $0, %rdx
+    mov %rax, (%rdi)
+    mov %rdx, %r9
+    lea 8(%rsi), %rsi
+    lea 8(%rdi), %rdi
+    dec %r8
+    jnz __loop_mul_1
+__end_mul_1:
+    mov %r9, %rax
+    ret
+
+.globl big_int_addmul_1_baseline
+big_int_addmul_1_baseline:
+    mov %rdx, %r8
+    xor %r9d, %r9d
+    test %r8, %r8
+    jz __end_addmul_1
+__loop_addmul_1:
+    mov (%rsi), %rax
+    mul %rcx
+    add (%rdi), %rax
+    adc $0, %rdx
+    add %r9, %rax
+    adc $0, %rdx
+    mov %rax, (%rdi)
+    mov %rdx, %r9
+    lea 8(%rsi), %rsi
+    lea 8(%rdi), %rdi
+    dec %r8
+    jnz __loop_addmul_1
+__end_addmul_1:
+    mov %r9, %rax
+    ret
+
+.globl big_int_submul_1_baseline
+big_int_submul_1_baseline:
+    mov %rdx, %r8
+    xor %r9d, %r9d
+    test %r8, %r8
+    jz __end_submul_1
+__loop_submul_1:
+    mov (%rsi), %rax
+    mul %rcx
+    mov (%rdi), %r10
+    sub %rax, %r10
+    adc $0, %rdx
+    sub %r9, %r10
+    adc $0, %rdx
+    mov %r10, (%rdi)
+    mov %rdx, %r9
+    lea 8(%rsi), %rsi
+    lea 8(%rdi), %rdi
+    dec %r8
+    jnz __loop_submul_1
+__end_submul_1:
+    mov %r9, %rax
+    ret
+
+.globl big_int_redc_1_baseline
+big_int_redc_1_baseline:
+    push %rbx
+    push %r12
+    push %r13
+    push %r14
+    mov %rdx, %r9
+    mov %rcx, %r10
+__outer_redc_1:
+    mov (%rsi), %rbx
+    imul %r8, %rbx
+    mov %rcx, %r11
+    mov %rsi, %r13
+    mov %r9, %r14
+    xor %r12d, %r12d
+__inner_redc_1:
+    mov (%r14), %rax
+    mul %rbx
+    add (%r13), %rax
+    adc $0, %rdx
+    add %r12, %rax
+    adc $0, %rdx
+    mov %rax, (%r13)
+    mov %rdx, %r12
+    lea 8(%r14), %r14
+    lea 8(%r13), %r13
+    dec %r11
+    jnz __inner_redc_1
+    mov %r12, (%rsi)
+    lea 8(%rsi), %rsi
+    dec %r10
+    jnz __outer_redc_1
+    mov %rcx, %r11
+    lea (,%rcx,8), %rdx
+    neg %rdx
+    add %rsi, %rdx
+    xor %eax, %eax
+__add_redc_1:
+    mov (%rsi), %r8
+    adc (%rdx), %r8
+    mov %r8, (%rdi)
+    lea 8(%rsi), %rsi
+    lea 8(%rdx), %rdx
+    lea 8(%rdi), %rdi
+    dec %r11
+    jnz __add_redc_1
+    setc %al
+    pop %r14
+    pop %r13
+    pop %r12
+    pop %rbx
+    ret
+
+# The exported multiplication kernels jump through big_int_kernels, which is filled in at startup with the fastest
+# variant the CPU supports.
+.globl big_int_mul_1
+big_int_mul_1:
+    jmp *big_int_kernels(%rip)
+
+.globl big_int_addmul_1
+big_int_addmul_1:
+    jmp *big_int_kernels+8(%rip)
+
+.globl big_int_submul_1
+big_int_submul_1:
+    jmp *big_int_kernels+16(%rip)
+
+.globl big_int_redc_1
+big_int_redc_1:
+    jmp *big_int_kernels+24(%rip)
+
+# BMI2: mulx takes the factor in rdx and leaves the flags alone.
+.globl big_int_mul_1_mulx
+big_int_mul_1_mulx:
+    mov %rdx, %r8
+    mov %rcx, %rdx
+    xor %r9d, %r9d
+    test %r8, %r8
+    jz __end_mul_1_mulx
+__loop_mul_1_mulx:
+    mulx (%rsi), %rax, %r10
+    add %r9, %rax
+    adc $0, %r10
+    mov %rax, (%rdi)
+    mov %r10, %r9
+    lea 8(%rsi), %rsi
+    lea 8(%rdi), %rdi
+    dec %r8
+    jnz __loop_mul_1_mulx
+__end_mul_1_mulx:
+    mov %r9, %rax
+    ret
+
+.globl big_int_addmul_1_mulx
+big_int_addmul_1_mulx:
+    mov %rdx, %r8
+    mov %rcx, %rdx
+    xor %r9d, %r9d
+    test %r8, %r8
+    jz __end_addmul_1_mulx
+__loop_addmul_1_mulx:
+    mulx (%rsi), %rax, %r10
+    add %r9, %rax
+    adc $0, %r10
+    add %rax, (%rdi)
+    adc $0, %r10
+    mov %r10, %r9
+    lea 8(%rsi), %rsi
+    lea 8(%rdi), %rdi
+    dec %r8
+    jnz __loop_addmul_1_mulx
+__end_addmul_1_mulx:
+    mov %r9, %rax
+    ret
+
+.globl big_int_submul_1_mulx
+big_int_submul_1_mulx:
+    mov %rdx, %r8
+    mov %rcx, %rdx
+    xor %r9d, %r9d
+    test %r8, %r8
+    jz __end_submul_1_mulx
+__loop_submul_1_mulx:
+    mulx (%rsi), %rax, %r10
+    add %r9, %rax
+    adc $0, %r10
+    sub %rax, (%rdi)
+    adc $0, %r10
+    mov %r10, %r9
+    lea 8(%rsi), %rsi
+    lea 8(%rdi), %rdi
+    dec %r8
+    jnz __loop_submul_1_mulx
+__end_submul_1_mulx:
+    mov %r9, %rax
+    ret
+
+# ADX: the carry into the next limb travels in CF (adcx) and the destination limb is added in OF (adox), so the two
+# chains never wait on each other. The loops count with jrcxz since dec would clobber OF.
+.globl big_int_addmul_1_adx
+big_int_addmul_1_adx:
+    xchg %rdx, %rcx
+    xor %r9d, %r9d
+    jrcxz __end_addmul_1_adx
+    mov %rcx, %r11
+    shr $1, %rcx
+    test $1, %r11b
+    jz __pairs_addmul_1_adx
+    mulx (%rsi), %rax, %r9
+    adox (%rdi), %rax
+    mov %rax, (%rdi)
+    lea 8(%rsi), %rsi
+    lea 8(%rdi), %rdi
+__pairs_addmul_1_adx:
+    jrcxz __carry_addmul_1_adx
+__loop_addmul_1_adx:
+    mulx (%rsi), %rax, %r10
+    adcx %r9, %rax
+    adox (%rdi), %rax
+    mov %rax, (%rdi)
+    mulx 8(%rsi), %rax, %r9
+    adcx %r10, %rax
+    adox 8(%rdi), %rax
+    mov %rax, 8(%rdi)
+    lea 16(%rsi), %rsi
+    lea 16(%rdi), %rdi
+    lea -1(%rcx), %rcx
+    jrcxz __carry_addmul_1_adx
+    jmp __loop_addmul_1_adx
+__carry_addmul_1_adx:
+    mov $0, %eax
+    adcx %rax, %r9
+    adox %rax, %r9
+__end_addmul_1_adx:
+    mov %r9, %rax
+    ret
+
+.globl big_int_redc_1_adx
+big_int_redc_1_adx:
+    push %rbx
+    push %r12
+    push %r13
+    push %r14
+    mov %rdx, %r9
+    mov %rcx, %r10
+    mov %rcx, %rbx
+__outer_redc_1_adx:
+    mov (%rsi), %rdx
+    imul %r8, %rdx
+    mov %rbx, %rcx
+    shr $1, %rcx
+    mov %rsi, %r13
+    mov %r9, %r14
+    xor %r12d, %r12d
+    test $1, %bl
+    jz __pairs_redc_1_adx
+    mulx (%r14), %rax, %r12
+    adox (%r13), %rax
+    mov %rax, (%r13)
+    lea 8(%r14), %r14
+    lea 8(%r13), %r13
+__pairs_redc_1_adx:
+    jrcxz __carry_redc_1_adx
+__inner_redc_1_adx:
+    mulx (%r14), %rax, %r11
+    adcx %r12, %rax
+    adox (%r13), %rax
+    mov %rax, (%r13)
+    mulx 8(%r14), %rax, %r12
+    adcx %r11, %rax
+    adox 8(%r13), %rax
+    mov %rax, 8(%r13)
+    lea 16(%r14), %r14
+    lea 16(%r13), %r13
+    lea -1(%rcx), %rcx
+    jrcxz __carry_redc_1_adx
+    jmp __inner_redc_1_adx
+__carry_redc_1_adx:
+    mov $0, %eax
+    adcx %rax, %r12
+    adox %rax, %r12
+    mov %r12, (%rsi)
+    lea 8(%rsi), %rsi
+    dec %r10
+    jnz __outer_redc_1_adx
+    mov %rbx, %r11
+    lea (,%rbx,8), %rdx
+    neg %rdx
+    add %rsi, %rdx
+    xor %eax, %eax
+__add_redc_1_adx:
+    mov (%rsi), %r8
+    adc (%rdx), %r8
+    mov %r8, (%rdi)
+    lea 8(%rsi), %rsi
+    lea 8(%rdx), %rdx
+    lea 8(%rdi), %rdi
+    dec %r11
+    jnz __add_redc_1_adx
+    setc %al
+    pop %r14
+    pop %r13
+    pop %r12
+    pop %rbx
+    ret
+
 .section .note.GNU-stack,"",@progbits
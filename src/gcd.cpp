@@ -0,0 +1,445 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "BigInt.hpp"
+#include "BigUint.hpp"
+#include "Instrumentation.hpp"
+#include "big_int.h"
+#include "limbs.hpp"
+
+namespace
+{
+using Uint128 = unsigned __int128;
+
+inline constexpr size_t BITS_IN_UINT64 = 64;
+inline constexpr size_t LEHMER_BITS = 127;
+inline constexpr size_t HGCD_MARGIN_BITS = 64;
+
+// Maps (a, b) to (a', b') with a' = +-(u0 a - v0 b) and b' = +-(u1 a - v1 b); a row is negated when its flag is set.
+struct LehmerMatrix final
+{
+    uint64_t u0;
+    uint64_t v0;
+    uint64_t u1;
+    uint64_t v1;
+    bool negative0;
+    bool negative1;
+};
+
+// Runs Euclid on the leading bits of (a, b) while Jebelean's condition proves each quotient is also the quotient of
+// the full values, and stops before a cofactor outgrows a limb. Returns false if not even one step is certain.
+bool lehmer_matrix(LehmerMatrix& matrix, Uint128 a_prev, Uint128 a)
+{
+    Uint128 u_prev = 1;
+    Uint128 v_prev = 0;
+    Uint128 u = 0;
+    Uint128 v = 1;
+    size_t steps = 0;
+    while (a != 0)
+    {
+        Uint128 quotient = 1;
+        if (a_prev - a >= a)
+        {
+            quotient = (a_prev >> 64) == 0 ? static_cast<uint64_t>(a_prev) / static_cast<uint64_t>(a) : a_prev / a;
+            if ((quotient >> 64) != 0)
+            {
+                break;
+            }
+        }
+
+        const Uint128 a_next = a_prev - quotient * a;
+        const Uint128 u_next = u_prev + quotient * u;
+        const Uint128 v_next = v_prev + quotient * v;
+        if ((std::max(u_next, v_next) >> 64) != 0 || a_next < std::max(u_next, v_next) ||
+            a - a_next < std::max(u + u_next, v + v_next))
+        {
+            break;
+        }
+
+        a_prev = std::exchange(a, a_next);
+        u_prev = std::exchange(u, u_next);
+        v_prev = std::exchange(v, v_next);
+        ++steps;
+    }
+
+    if (steps == 0)
+    {
+        return false;
+    }
+    matrix = {static_cast<uint64_t>(u_prev), static_cast<uint64_t>(v_prev), static_cast<uint64_t>(u),
+              static_cast<uint64_t>(v), false, false};
+    return true;
+}
+
+// res = |x x_factor - y y_factor| in size + 1 limbs, with y_size <= size; returns whether the difference was negative.
+bool combine(uint64_t* res, const uint64_t* x, const size_t size, const uint64_t x_factor, const uint64_t* y,
+             const size_t y_size, const uint64_t y_factor)
+{
+    res[size] = big_int_mul_1(res, x, size, x_factor);
+    const uint64_t borrow = big_int_submul_1(res, y, y_size, y_factor);
+    if (limbs::sub_limb(res + y_size, size + 1 - y_size, borrow) != 0)
+    {
+        limbs::negate(res, size + 1);
+        return true;
+    }
+    return false;
+}
+
+// LEHMER_BITS bits of the value starting at bit shift.
+Uint128 extract_bits(const LimbVector& number, const size_t shift)
+{
+    const size_t first = shift / BITS_IN_UINT64;
+    const uint32_t offset = shift % BITS_IN_UINT64;
+    const auto limb = [&](const size_t index) { return index < number.size() ? number[index] : 0; };
+
+    Uint128 res = (static_cast<Uint128>(limb(first + 1)) << 64) | limb(first);
+    if (offset != 0)
+    {
+        res = (res >> offset) | (static_cast<Uint128>(limb(first + 2)) << (128 - offset));
+    }
+    return res & ((static_cast<Uint128>(1) << LEHMER_BITS) - 1);
+}
+
+Uint128 binary_gcd(Uint128 a, Uint128 b)
+{
+    const auto trailing_zeros = [](const Uint128 value)
+    {
+        const uint64_t low = static_cast<uint64_t>(value);
+        return low != 0 ? std::countr_zero(low) : 64 + std::countr_zero(static_cast<uint64_t>(value >> 64));
+    };
+
+    if (a == 0 || b == 0)
+    {
+        return a | b;
+    }
+
+    const int shift = trailing_zeros(a | b);
+    a >>= trailing_zeros(a);
+    while (b != 0)
+    {
+        b >>= trailing_zeros(b);
+        if (a > b)
+        {
+            std::swap(a, b);
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+} // namespace
+
+// (a', b') = M (a, b) for signed entries with determinant +-1, which keeps gcd(a, b).
+struct GcdMatrix final
+{
+    BigInt m00 = 1;
+    BigInt m01 = 0;
+    BigInt m10 = 0;
+    BigInt m11 = 1;
+};
+
+// Lehmer steps on the leading 127 bits, a half-gcd recursion once the operands reach HGCD_THRESHOLD limbs and a binary
+// gcd when both fit in two limbs. Every step is a unimodular transform followed by absolute values, so a half-gcd
+// matrix that is not exact for the full values (its quotients are only guarded by a margin) costs progress, never the
+// gcd.
+class Gcd final
+{
+public:
+    static BigUint gcd(BigUint a, BigUint b)
+    {
+        const instrumentation::Scope scope(instrumentation::Operation::GCD,
+                                           std::max(a._number.size(), b._number.size()));
+        if (a < b)
+        {
+            a._number.swap(b._number);
+        }
+        run(a, b, nullptr, nullptr);
+        return a;
+    }
+
+    // gcd = x a + y b, with |x| < b / gcd unless b is zero.
+    static std::tuple<BigUint, BigInt, BigInt> gcdext(const BigUint& a, const BigUint& b)
+    {
+        const instrumentation::Scope scope(instrumentation::Operation::GCD,
+                                           std::max(a._number.size(), b._number.size()));
+        if (b.is_zero())
+        {
+            return {a, BigInt(a.is_zero() ? 0 : 1), BigInt(0)};
+        }
+
+        BigUint gcd = a;
+        BigUint other = b;
+        BigInt gcd_cofactor = 1;
+        BigInt other_cofactor = 0;
+        if (gcd < other)
+        {
+            gcd._number.swap(other._number);
+            std::swap(gcd_cofactor, other_cofactor);
+        }
+        run(gcd, other, &gcd_cofactor, &other_cofactor);
+
+        gcd_cofactor %= BigInt(b / gcd);
+        BigInt b_cofactor = BigInt(gcd) - gcd_cofactor * a;
+        b_cofactor /= b;
+        return {std::move(gcd), std::move(gcd_cofactor), std::move(b_cofactor)};
+    }
+
+private:
+    // Reduces (a, b), a >= b, to (gcd, 0). The cofactors, when given, are a column that goes through every transform.
+    static void run(BigUint& a, BigUint& b, BigInt* a_cofactor, BigInt* b_cofactor)
+    {
+        instrumentation::record_tier(b._number.size() >= limbs::HGCD_THRESHOLD ? instrumentation::Tier::GCD_HALF_GCD
+                                                                               : instrumentation::Tier::GCD_LEHMER);
+        while (!b.is_zero())
+        {
+            if (a_cofactor == nullptr && a._number.size() <= 2)
+            {
+                const Uint128 res = binary_gcd(to_uint128(a), to_uint128(b));
+                a._number = {static_cast<uint64_t>(res), static_cast<uint64_t>(res >> 64)};
+                a.fix_size();
+                b = 0;
+                return;
+            }
+
+            const size_t bits = a.bit_width();
+            if (b._number.size() >= limbs::HGCD_THRESHOLD && bits - b.bit_width() < BITS_IN_UINT64)
+            {
+                const size_t shift = bits / 3;
+                BigUint p = a >> shift;
+                BigUint q = b >> shift;
+                GcdMatrix matrix;
+                hgcd(p, q, matrix);
+                apply(a, b, matrix);
+                if (a_cofactor != nullptr)
+                {
+                    apply_column(*a_cofactor, *b_cofactor, matrix);
+                }
+                if (a.bit_width() < bits)
+                {
+                    continue;
+                }
+            }
+
+            if (b.is_zero())
+            {
+                break;
+            }
+            LehmerMatrix matrix{};
+            if (lehmer_step(a, b, matrix))
+            {
+                if (a_cofactor != nullptr)
+                {
+                    apply_column(*a_cofactor, *b_cofactor, matrix);
+                }
+            }
+            else
+            {
+                division_step(a, b, a_cofactor, b_cofactor, nullptr, nullptr);
+            }
+        }
+    }
+
+    // Reduces p >= q of n bits until q has about n / 2 + HGCD_MARGIN_BITS bits, folding every step into matrix.
+    static void hgcd(BigUint& p, BigUint& q, GcdMatrix& matrix)
+    {
+        const size_t target = p.bit_width() / 2 + HGCD_MARGIN_BITS;
+        while (q.bit_width() > target)
+        {
+            const size_t bits = p.bit_width();
+            const size_t reduce = std::min(bits - target, bits / 3);
+            if (reduce < limbs::HGCD_THRESHOLD * BITS_IN_UINT64 / 2)
+            {
+                break;
+            }
+
+            const size_t shift = bits - 2 * reduce;
+            BigUint p_top = p >> shift;
+            BigUint q_top = q >> shift;
+            GcdMatrix step;
+            hgcd(p_top, q_top, step);
+            apply(p, q, step);
+            compose(matrix, step);
+            if (p.bit_width() >= bits)
+            {
+                break;
+            }
+        }
+
+        while (!q.is_zero() && q.bit_width() > target)
+        {
+            LehmerMatrix step{};
+            if (lehmer_step(p, q, step))
+            {
+                apply_column(matrix.m00, matrix.m10, step);
+                apply_column(matrix.m01, matrix.m11, step);
+            }
+            else
+            {
+                division_step(p, q, &matrix.m00, &matrix.m10, &matrix.m01, &matrix.m11);
+            }
+        }
+    }
+
+    static bool lehmer_step(BigUint& a, BigUint& b, LehmerMatrix& matrix)
+    {
+        const size_t bits = a.bit_width();
+        const size_t shift = bits > LEHMER_BITS ? bits - LEHMER_BITS : 0;
+        if (!lehmer_matrix(matrix, extract_bits(a._number, shift), extract_bits(b._number, shift)))
+        {
+            return false;
+        }
+
+        const size_t size = a._number.size();
+        limbs::ScratchArena arena;
+        uint64_t* const new_a = arena.allocate(2 * (size + 1));
+        uint64_t* const new_b = new_a + size + 1;
+        matrix.negative0 = combine(new_a, a._number.data(), size, matrix.u0, b._number.data(), b._number.size(),
+                                   matrix.v0);
+        matrix.negative1 = combine(new_b, a._number.data(), size, matrix.u1, b._number.data(), b._number.size(),
+                                   matrix.v1);
+
+        a._number.resize_for_overwrite(size + 1);
+        std::copy(new_a, new_a + size + 1, a._number.data());
+        a.fix_size();
+        b._number.resize_for_overwrite(size + 1);
+        std::copy(new_b, new_b + size + 1, b._number.data());
+        b.fix_size();
+        if (a < b)
+        {
+            a._number.swap(b._number);
+            std::swap(matrix.u0, matrix.u1);
+            std::swap(matrix.v0, matrix.v1);
+            std::swap(matrix.negative0, matrix.negative1);
+        }
+        return true;
+    }
+
+    // (a, b) -> (b, a mod b), applied to up to two columns.
+    static void division_step(BigUint& a, BigUint& b, BigInt* top0, BigInt* bottom0, BigInt* top1, BigInt* bottom1)
+    {
+        BigUint quotient;
+        BigUint remainder;
+        BigUint::divmod(quotient, remainder, a, b);
+        a._number.swap(b._number);
+        b._number.swap(remainder._number);
+
+        for (const auto& [top, bottom] : {std::pair{top0, bottom0}, std::pair{top1, bottom1}})
+        {
+            if (top != nullptr)
+            {
+                *top -= *bottom * quotient;
+                std::swap(*top, *bottom);
+            }
+        }
+    }
+
+    static void apply(BigUint& a, BigUint& b, GcdMatrix& matrix)
+    {
+        BigInt new_a = matrix.m00 * a + matrix.m01 * b;
+        BigInt new_b = matrix.m10 * a + matrix.m11 * b;
+        if (new_a.is_neg())
+        {
+            matrix.m00.negate();
+            matrix.m01.negate();
+        }
+        if (new_b.is_neg())
+        {
+            matrix.m10.negate();
+            matrix.m11.negate();
+        }
+
+        a = new_a.abs();
+        b = new_b.abs();
+        if (a < b)
+        {
+            a._number.swap(b._number);
+            std::swap(matrix.m00, matrix.m10);
+            std::swap(matrix.m01, matrix.m11);
+        }
+    }
+
+    static void apply_column(BigInt& top, BigInt& bottom, const LehmerMatrix& matrix)
+    {
+        BigInt new_top = top * matrix.u0 - bottom * matrix.v0;
+        BigInt new_bottom = top * matrix.u1 - bottom * matrix.v1;
+        if (matrix.negative0)
+        {
+            new_top.negate();
+        }
+        if (matrix.negative1)
+        {
+            new_bottom.negate();
+        }
+        top = std::move(new_top);
+        bottom = std::move(new_bottom);
+    }
+
+    static void apply_column(BigInt& top, BigInt& bottom, const GcdMatrix& matrix)
+    {
+        BigInt new_top = matrix.m00 * top + matrix.m01 * bottom;
+        bottom = matrix.m10 * top + matrix.m11 * bottom;
+        top = std::move(new_top);
+    }
+
+    // matrix = step matrix
+    static void compose(GcdMatrix& matrix, const GcdMatrix& step)
+    {
+        apply_column(matrix.m00, matrix.m10, step);
+        apply_column(matrix.m01, matrix.m11, step);
+    }
+
+    static Uint128 to_uint128(const BigUint& number)
+    {
+        const LimbVector& limbs = number._number;
+        return limbs.size() == 1 ? limbs[0] : (static_cast<Uint128>(limbs[1]) << 64) | limbs[0];
+    }
+};
+
+BigUint BigUint::gcd(const BigUint& other) const
+{
+    return Gcd::gcd(*this, other);
+}
+
+std::tuple<BigInt, BigInt, BigInt> BigInt::gcdext(const BigInt& other) const
+{
+    auto [gcd, self_cofactor, other_cofactor] = Gcd::gcdext(_number, other._number);
+    // negate() flips the sign of zero as well, and a zero cofactor must not come back as -0.
+    if (_is_negative && !self_cofactor.is_zero())
+    {
+        self_cofactor.negate();
+    }
+    if (other._is_negative && !other_cofactor.is_zero())
+    {
+        other_cofactor.negate();
+    }
+    return {BigInt(std::move(gcd)), std::move(self_cofactor), std::move(other_cofactor)};
+}
+
+BigInt BigInt::mod_inverse(const BigInt& modulus) const
+{
+    if (modulus.is_zero())
+    {
+        throw std::invalid_argument("Modulus cannot be zero");
+    }
+
+    const BigUint& mod = modulus._number;
+    BigUint reduced = _number % mod;
+    if (_is_negative && !reduced.is_zero())
+    {
+        reduced = mod - reduced;
+    }
+
+    auto [gcd, inverse, unused] = Gcd::gcdext(reduced, mod);
+    if (gcd != BigUint(1))
+    {
+        throw std::invalid_argument("Value is not invertible modulo the modulus");
+    }
+    if (inverse.is_neg())
+    {
+        inverse += BigInt(mod);
+    }
+    return inverse;
+}
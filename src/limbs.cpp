@@ -0,0 +1,88 @@
+#include "limbs.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace limbs
+{
+uint64_t add_limb(uint64_t* res, const size_t size, uint64_t carry)
+{
+    for (size_t i = 0; i < size && carry != 0; ++i)
+    {
+        res[i] += carry;
+        carry = res[i] < carry;
+    }
+    return carry;
+}
+
+uint64_t sub_limb(uint64_t* res, const size_t size, uint64_t borrow)
+{
+    for (size_t i = 0; i < size && borrow != 0; ++i)
+    {
+        const uint64_t before = res[i];
+        res[i] -= borrow;
+        borrow = before < borrow;
+    }
+    return borrow;
+}
+
+void negate(uint64_t* res, const size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        res[i] = ~res[i];
+    }
+    add_limb(res, size, 1);
+}
+
+void divexact_1(uint64_t* res, const size_t size, const uint64_t divisor)
+{
+    uint64_t inverse = divisor;
+    for (int i = 0; i < 5; ++i)
+    {
+        inverse *= 2 - divisor * inverse;
+    }
+
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const uint64_t value = res[i] - borrow;
+        const uint64_t quotient = value * inverse;
+        borrow = static_cast<uint64_t>((static_cast<__uint128_t>(quotient) * divisor) >> 64) + (res[i] < borrow);
+        res[i] = quotient;
+    }
+}
+
+uint64_t lshift(uint64_t* res, const uint64_t* a, const size_t size, const uint32_t bits)
+{
+    const uint64_t out = a[size - 1] >> (64 - bits);
+    for (size_t i = size - 1; i > 0; --i)
+    {
+        res[i] = (a[i] << bits) | (a[i - 1] >> (64 - bits));
+    }
+    res[0] = a[0] << bits;
+    return out;
+}
+
+uint64_t rshift(uint64_t* res, const uint64_t* a, const size_t size, const uint32_t bits)
+{
+    const uint64_t out = a[0] << (64 - bits);
+    for (size_t i = 0; i + 1 < size; ++i)
+    {
+        res[i] = (a[i] >> bits) | (a[i + 1] << (64 - bits));
+    }
+    res[size - 1] = a[size - 1] >> bits;
+    return out;
+}
+
+int cmp(const uint64_t* a, const uint64_t* b, const size_t size)
+{
+    for (size_t i = size; i > 0; --i)
+    {
+        if (a[i - 1] != b[i - 1])
+        {
+            return a[i - 1] < b[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+} // namespace limbs
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Instrumentation.hpp"
+#include "limbs.hpp"
+
+namespace
+{
+inline constexpr size_t POOL_MIN_CLASS = 2;
+inline constexpr size_t POOL_CLASSES = 64;
+inline constexpr size_t POOL_CACHED_LIMBS = size_t{1} << 23;
+inline constexpr size_t SCRATCH_BLOCK_LIMBS = size_t{1} << 14;
+
+size_t size_class(const size_t size)
+{
+    return std::max<size_t>(POOL_MIN_CLASS, std::bit_width(size - 1));
+}
+
+// Limbs released after the thread's pool is gone (static BigUints at exit) go straight back to the heap.
+thread_local bool pool_destroyed = false;
+
+// Buffers are rounded up to a power of two and kept on per-thread free lists until POOL_CACHED_LIMBS limbs are
+// cached. Every buffer comes from new[], so a buffer freed on another thread simply joins that thread's lists.
+class LimbPool final
+{
+public:
+    uint64_t* allocate(const size_t size)
+    {
+        const size_t index = size_class(size);
+        std::vector<uint64_t*>& free_list = _free_lists[index];
+        if (free_list.empty())
+        {
+            return new uint64_t[size_t{1} << index];
+        }
+
+        uint64_t* const data = free_list.back();
+        free_list.pop_back();
+        _cached_limbs -= size_t{1} << index;
+        return data;
+    }
+
+    void deallocate(uint64_t* data, const size_t size)
+    {
+        const size_t index = size_class(size);
+        if (_cached_limbs + (size_t{1} << index) > POOL_CACHED_LIMBS)
+        {
+            delete[] data;
+            return;
+        }
+
+        _free_lists[index].push_back(data);
+        _cached_limbs += size_t{1} << index;
+    }
+
+private:
+    std::array<std::vector<uint64_t*>, POOL_CLASSES> _free_lists;
+    size_t _cached_limbs = 0;
+
+public:
+    LimbPool() = default;
+    LimbPool(const LimbPool&) = delete;
+    LimbPool& operator=(const LimbPool&) = delete;
+    LimbPool(LimbPool&&) = delete;
+    LimbPool& operator=(LimbPool&&) = delete;
+
+    ~LimbPool()
+    {
+        pool_destroyed = true;
+        for (const std::vector<uint64_t*>& free_list : _free_lists)
+        {
+            for (uint64_t* const data : free_list)
+            {
+                delete[] data;
+            }
+        }
+    }
+};
+
+thread_local LimbPool pool;
+
+uint64_t* pool_allocate(const size_t size)
+{
+    return pool_destroyed ? new uint64_t[size] : pool.allocate(size);
+}
+
+void pool_deallocate(uint64_t* data, const size_t size)
+{
+    if (pool_destroyed)
+    {
+        delete[] data;
+        return;
+    }
+    pool.deallocate(data, size);
+}
+
+uint64_t* heap_allocate(const size_t size)
+{
+    return new uint64_t[size];
+}
+
+void heap_deallocate(uint64_t* data, size_t /*size*/)
+{
+    delete[] data;
+}
+
+constinit limbs::Allocator current_allocator{pool_allocate, pool_deallocate};
+
+struct ScratchBlock final
+{
+    std::unique_ptr<uint64_t[]> data;
+    size_t size = 0;
+};
+
+// A per-thread stack of blocks. Arenas rewind it to where they started, so the blocks are reused by every later
+// arena on the thread.
+struct ScratchStack final
+{
+    std::vector<ScratchBlock> blocks;
+    size_t block = 0;
+    size_t offset = 0;
+};
+
+thread_local ScratchStack scratch_stack;
+} // namespace
+
+namespace limbs
+{
+Allocator pool_allocator()
+{
+    return {pool_allocate, pool_deallocate};
+}
+
+Allocator heap_allocator()
+{
+    return {heap_allocate, heap_deallocate};
+}
+
+void set_allocator(const Allocator& allocator)
+{
+    current_allocator = allocator;
+}
+
+uint64_t* allocate(const size_t size)
+{
+    instrumentation::record_allocation();
+    return current_allocator.allocate(size);
+}
+
+void deallocate(uint64_t* data, const size_t size)
+{
+    current_allocator.deallocate(data, size);
+}
+
+ScratchArena::ScratchArena() : _block(scratch_stack.block), _offset(scratch_stack.offset) {}
+
+ScratchArena::~ScratchArena()
+{
+    scratch_stack.block = _block;
+    scratch_stack.offset = _offset;
+}
+
+uint64_t* ScratchArena::allocate(const size_t size)
+{
+    ScratchStack& stack = scratch_stack;
+    for (; stack.block < stack.blocks.size(); ++stack.block, stack.offset = 0)
+    {
+        ScratchBlock& block = stack.blocks[stack.block];
+        if (block.size - stack.offset >= size)
+        {
+            uint64_t* const data = block.data.get() + stack.offset;
+            stack.offset += size;
+            return data;
+        }
+    }
+
+    const size_t block_size =
+        std::max({size, SCRATCH_BLOCK_LIMBS, stack.blocks.empty() ? size_t{0} : 2 * stack.blocks.back().size});
+    stack.blocks.push_back({std::make_unique_for_overwrite<uint64_t[]>(block_size), block_size});
+    stack.block = stack.blocks.size() - 1;
+    stack.offset = size;
+    return stack.blocks.back().data.get();
+}
+} // namespace limbs
@@ -0,0 +1,277 @@
+#include <immintrin.h>
+#include <cstddef>
+#include <cstdint>
+#include "limbs.hpp"
+
+namespace
+{
+using Uint128 = unsigned __int128;
+
+constexpr size_t LANES = 4;
+
+// Every batch kernel walks the items of a lane group together, limb by limb, with the carries kept per item. The
+// scalar loops finish whatever is left over after the last full group.
+void add_scalar(uint64_t* res, const uint64_t* a, const size_t size, const size_t count, uint64_t* carries,
+                const size_t first)
+{
+    for (size_t i = first; i < count; ++i)
+    {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < size; ++j)
+        {
+            const Uint128 sum = static_cast<Uint128>(res[j * count + i]) + a[j * count + i] + carry;
+            res[j * count + i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+        if (carries != nullptr)
+        {
+            carries[i] = carry;
+        }
+    }
+}
+
+void sub_scalar(uint64_t* res, const uint64_t* a, const size_t size, const size_t count, uint64_t* borrows,
+                const size_t first)
+{
+    for (size_t i = first; i < count; ++i)
+    {
+        uint64_t borrow = 0;
+        for (size_t j = 0; j < size; ++j)
+        {
+            const Uint128 difference = static_cast<Uint128>(res[j * count + i]) - a[j * count + i] - borrow;
+            res[j * count + i] = static_cast<uint64_t>(difference);
+            borrow = static_cast<uint64_t>(difference >> 64) & 1;
+        }
+        if (borrows != nullptr)
+        {
+            borrows[i] = borrow;
+        }
+    }
+}
+
+void mul_1_scalar(uint64_t* res, const uint64_t* a, const size_t size, const size_t count, const uint64_t* factors,
+                  const bool accumulate, uint64_t* carries, const size_t first)
+{
+    for (size_t i = first; i < count; ++i)
+    {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < size; ++j)
+        {
+            Uint128 product = static_cast<Uint128>(a[j * count + i]) * factors[i] + carry;
+            if (accumulate)
+            {
+                product += res[j * count + i];
+            }
+            res[j * count + i] = static_cast<uint64_t>(product);
+            carry = static_cast<uint64_t>(product >> 64);
+        }
+        if (carries != nullptr)
+        {
+            carries[i] = carry;
+        }
+    }
+}
+
+void cmp_scalar(const uint64_t* a, const uint64_t* b, const size_t size, const size_t count, int8_t* res,
+                const size_t first)
+{
+    for (size_t i = first; i < count; ++i)
+    {
+        res[i] = 0;
+        for (size_t j = size; j-- > 0;)
+        {
+            if (a[j * count + i] != b[j * count + i])
+            {
+                res[i] = a[j * count + i] > b[j * count + i] ? 1 : -1;
+                break;
+            }
+        }
+    }
+}
+
+// AVX2 has no unsigned 64-bit compare, so both sides are biased by 2^63 and compared signed.
+__attribute__((target("avx2"))) __m256i less_than(const __m256i a, const __m256i b)
+{
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+}
+
+__attribute__((target("avx2"))) __m256i load(const uint64_t* data)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+__attribute__((target("avx2"))) void store(uint64_t* data, const __m256i value)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value);
+}
+
+// Comparison masks are all ones, so subtracting them adds one.
+__attribute__((target("avx2"))) size_t add_avx2(uint64_t* res, const uint64_t* a, const size_t size,
+                                                const size_t count, uint64_t* carries)
+{
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        __m256i carry = _mm256_setzero_si256();
+        for (size_t j = 0; j < size; ++j)
+        {
+            const __m256i x = load(res + j * count + i);
+            const __m256i partial = _mm256_add_epi64(x, load(a + j * count + i));
+            const __m256i sum = _mm256_add_epi64(partial, carry);
+            carry = _mm256_sub_epi64(_mm256_setzero_si256(),
+                                     _mm256_or_si256(less_than(partial, x), less_than(sum, partial)));
+            store(res + j * count + i, sum);
+        }
+        if (carries != nullptr)
+        {
+            store(carries + i, carry);
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t sub_avx2(uint64_t* res, const uint64_t* a, const size_t size,
+                                                const size_t count, uint64_t* borrows)
+{
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        __m256i borrow = _mm256_setzero_si256();
+        for (size_t j = 0; j < size; ++j)
+        {
+            const __m256i x = load(res + j * count + i);
+            const __m256i y = load(a + j * count + i);
+            const __m256i partial = _mm256_sub_epi64(x, y);
+            store(res + j * count + i, _mm256_sub_epi64(partial, borrow));
+            borrow = _mm256_sub_epi64(_mm256_setzero_si256(),
+                                      _mm256_or_si256(less_than(x, y), less_than(partial, borrow)));
+        }
+        if (borrows != nullptr)
+        {
+            store(borrows + i, borrow);
+        }
+    }
+    return i;
+}
+
+// The full 128-bit products come from four 32 x 32 multiplications per lane; the middle terms fit 34 bits together.
+__attribute__((target("avx2"))) size_t mul_1_avx2(uint64_t* res, const uint64_t* a, const size_t size,
+                                                  const size_t count, const uint64_t* factors, const bool accumulate,
+                                                  uint64_t* carries)
+{
+    const __m256i low_mask = _mm256_set1_epi64x(UINT32_MAX);
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        const __m256i factor = load(factors + i);
+        const __m256i factor_high = _mm256_srli_epi64(factor, 32);
+        __m256i carry = _mm256_setzero_si256();
+        for (size_t j = 0; j < size; ++j)
+        {
+            const __m256i x = load(a + j * count + i);
+            const __m256i x_high = _mm256_srli_epi64(x, 32);
+            const __m256i low_low = _mm256_mul_epu32(x, factor);
+            const __m256i low_high = _mm256_mul_epu32(x, factor_high);
+            const __m256i high_low = _mm256_mul_epu32(x_high, factor);
+            const __m256i high_high = _mm256_mul_epu32(x_high, factor_high);
+
+            const __m256i middle =
+                _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(low_low, 32), _mm256_and_si256(low_high, low_mask)),
+                                 _mm256_and_si256(high_low, low_mask));
+            __m256i low = _mm256_or_si256(_mm256_and_si256(low_low, low_mask), _mm256_slli_epi64(middle, 32));
+            __m256i high = _mm256_add_epi64(
+                _mm256_add_epi64(high_high, _mm256_srli_epi64(low_high, 32)),
+                _mm256_add_epi64(_mm256_srli_epi64(high_low, 32), _mm256_srli_epi64(middle, 32)));
+
+            low = _mm256_add_epi64(low, carry);
+            high = _mm256_sub_epi64(high, less_than(low, carry));
+            if (accumulate)
+            {
+                const __m256i addend = load(res + j * count + i);
+                low = _mm256_add_epi64(low, addend);
+                high = _mm256_sub_epi64(high, less_than(low, addend));
+            }
+            store(res + j * count + i, low);
+            carry = high;
+        }
+        if (carries != nullptr)
+        {
+            store(carries + i, carry);
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t cmp_avx2(const uint64_t* a, const uint64_t* b, const size_t size,
+                                                const size_t count, int8_t* res)
+{
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+    {
+        __m256i greater = _mm256_setzero_si256();
+        __m256i less = _mm256_setzero_si256();
+        for (size_t j = size; j-- > 0;)
+        {
+            const __m256i x = load(a + j * count + i);
+            const __m256i y = load(b + j * count + i);
+            const __m256i undecided = _mm256_xor_si256(_mm256_or_si256(greater, less), _mm256_set1_epi64x(-1));
+            greater = _mm256_or_si256(greater, _mm256_and_si256(undecided, less_than(y, x)));
+            less = _mm256_or_si256(less, _mm256_and_si256(undecided, less_than(x, y)));
+            if (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_or_si256(greater, less))) == 0xF)
+            {
+                break;
+            }
+        }
+
+        alignas(32) int64_t order[LANES];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(order), _mm256_sub_epi64(less, greater));
+        for (size_t lane = 0; lane < LANES; ++lane)
+        {
+            res[i + lane] = static_cast<int8_t>(order[lane]);
+        }
+    }
+    return i;
+}
+
+bool has_avx2()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+} // namespace
+
+namespace limbs
+{
+void batch_add(uint64_t* res, const uint64_t* a, const size_t size, const size_t count, uint64_t* carries)
+{
+    const size_t done = has_avx2() ? add_avx2(res, a, size, count, carries) : 0;
+    add_scalar(res, a, size, count, carries, done);
+}
+
+void batch_sub(uint64_t* res, const uint64_t* a, const size_t size, const size_t count, uint64_t* borrows)
+{
+    const size_t done = has_avx2() ? sub_avx2(res, a, size, count, borrows) : 0;
+    sub_scalar(res, a, size, count, borrows, done);
+}
+
+void batch_mul_1(uint64_t* res, const uint64_t* a, const size_t size, const size_t count, const uint64_t* factors,
+                 uint64_t* carries)
+{
+    const size_t done = has_avx2() ? mul_1_avx2(res, a, size, count, factors, false, carries) : 0;
+    mul_1_scalar(res, a, size, count, factors, false, carries, done);
+}
+
+void batch_addmul_1(uint64_t* res, const uint64_t* a, const size_t size, const size_t count, const uint64_t* factors,
+                    uint64_t* carries)
+{
+    const size_t done = has_avx2() ? mul_1_avx2(res, a, size, count, factors, true, carries) : 0;
+    mul_1_scalar(res, a, size, count, factors, true, carries, done);
+}
+
+void batch_cmp(const uint64_t* a, const uint64_t* b, const size_t size, const size_t count, int8_t* res)
+{
+    const size_t done = has_avx2() ? cmp_avx2(a, b, size, count, res) : 0;
+    cmp_scalar(a, b, size, count, res, done);
+}
+} // namespace limbs
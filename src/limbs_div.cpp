@@ -0,0 +1,447 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "Instrumentation.hpp"
+#include "big_int.h"
+#include "limbs.hpp"
+
+namespace
+{
+inline uint64_t div_2by1_preinv(const uint64_t high, const uint64_t low, const limbs::LimbDivisor& den,
+                                uint64_t& remainder)
+{
+    const __uint128_t estimate = static_cast<__uint128_t>(den.inverse) * high +
+                                 ((static_cast<__uint128_t>(high) << 64) | low);
+    uint64_t quotient = static_cast<uint64_t>(estimate >> 64) + 1;
+    remainder = low - quotient * den.divisor;
+    if (remainder > static_cast<uint64_t>(estimate))
+    {
+        --quotient;
+        remainder += den.divisor;
+    }
+    if (remainder >= den.divisor)
+    {
+        ++quotient;
+        remainder -= den.divisor;
+    }
+    return quotient;
+}
+
+bool div_qr(uint64_t* quotient, uint64_t* num, size_t num_size, const uint64_t* den, size_t den_size);
+
+// Every division below works on a normalized divisor (top bit set). The quotient gets num_size - den_size limbs, the
+// remainder replaces the low den_size limbs of the numerator and the returned flag is the quotient's extra top limb.
+
+// Knuth's Algorithm D. The estimate from the top two numerator limbs, corrected against the second divisor limb, is
+// off by at most one.
+bool divrem_basecase(uint64_t* quotient, uint64_t* num, const size_t num_size, const uint64_t* den,
+                     const size_t den_size)
+{
+    uint64_t* const top = num + num_size - den_size;
+    const bool high = limbs::cmp(top, den, den_size) >= 0;
+    if (high)
+    {
+        big_int_sub(top, den_size, den, den_size);
+    }
+
+    const uint64_t d1 = den[den_size - 1];
+    const uint64_t d0 = den[den_size - 2];
+    const limbs::LimbDivisor top_divisor(d1);
+
+    for (size_t j = num_size - den_size; j-- > 0;)
+    {
+        uint64_t* const window = num + j;
+        const uint64_t n2 = window[den_size];
+        const uint64_t n1 = window[den_size - 1];
+        const uint64_t n0 = window[den_size - 2];
+
+        uint64_t estimate = 0;
+        uint64_t remainder = 0;
+        bool remainder_overflow = false;
+        if (n2 >= d1)
+        {
+            estimate = ~0ULL;
+            remainder = n1 + d1;
+            remainder_overflow = remainder < n1;
+        }
+        else
+        {
+            estimate = div_2by1_preinv(n2, n1, top_divisor, remainder);
+        }
+
+        while (!remainder_overflow &&
+               static_cast<__uint128_t>(estimate) * d0 > ((static_cast<__uint128_t>(remainder) << 64) | n0))
+        {
+            --estimate;
+            remainder += d1;
+            remainder_overflow = remainder < d1;
+        }
+
+        const uint64_t borrow = big_int_submul_1(window, den, den_size, estimate);
+        const bool negative = window[den_size] < borrow;
+        window[den_size] -= borrow;
+        if (negative)
+        {
+            --estimate;
+            window[den_size] += big_int_add(window, den_size, den, den_size);
+        }
+
+        quotient[j] = estimate;
+    }
+
+    return high;
+}
+
+// Burnikel-Ziegler: a 2n by n division is two recursive (n + n/2) by n/2 divisions, each followed by a multiplication
+// that folds the remaining divisor limbs into the partial remainder.
+bool divrem_dc_n(uint64_t* quotient, uint64_t* num, const uint64_t* den, const size_t size)
+{
+    const size_t low = size / 2;
+    const size_t high = size - low;
+    limbs::ScratchArena arena;
+    uint64_t* const product = arena.allocate(size);
+
+    uint64_t quotient_high = div_qr(quotient + low, num + 2 * low, 2 * high, den + low, high);
+    limbs::mul(product, quotient + low, high, den, low);
+    uint64_t borrow = big_int_sub(num + low, size, product, size);
+    if (quotient_high != 0)
+    {
+        borrow += big_int_sub(num + size, low, den, low);
+    }
+    while (borrow != 0)
+    {
+        quotient_high -= limbs::sub_limb(quotient + low, high, 1);
+        borrow -= big_int_add(num + low, size, den, size);
+    }
+
+    const bool quotient_low = div_qr(quotient, num + high, 2 * low, den + high, low);
+    limbs::mul(product, den, high, quotient, low);
+    borrow = big_int_sub(num, size, product, size);
+    if (quotient_low)
+    {
+        borrow += big_int_sub(num + low, high, den, high);
+    }
+    while (borrow != 0)
+    {
+        limbs::sub_limb(quotient, low, 1);
+        borrow -= big_int_add(num, size, den, size);
+    }
+
+    return quotient_high != 0;
+}
+
+// With fewer quotient limbs than divisor limbs, the quotient of the top 2 * q limbs by the top q divisor limbs is at
+// most a few units too large, and one multiplication by the dropped divisor limbs corrects it.
+bool divrem_truncated(uint64_t* quotient, uint64_t* num, const size_t num_size, const uint64_t* den,
+                      const size_t den_size)
+{
+    const size_t quotient_size = num_size - den_size;
+    const size_t dropped = den_size - quotient_size;
+
+    uint64_t quotient_high = div_qr(quotient, num + dropped, 2 * quotient_size, den + dropped, quotient_size);
+
+    limbs::ScratchArena arena;
+    uint64_t* const product = arena.allocate(den_size);
+    limbs::mul(product, quotient, quotient_size, den, dropped);
+    uint64_t borrow = big_int_sub(num, den_size, product, den_size);
+    if (quotient_high != 0)
+    {
+        borrow += big_int_sub(num + quotient_size, dropped, den, dropped);
+    }
+    while (borrow != 0)
+    {
+        quotient_high -= limbs::sub_limb(quotient, quotient_size, 1);
+        borrow -= big_int_add(num, den_size, den, den_size);
+    }
+
+    return quotient_high != 0;
+}
+
+bool div_qr(uint64_t* quotient, uint64_t* num, const size_t num_size, const uint64_t* den, const size_t den_size)
+{
+    const size_t quotient_size = num_size - den_size;
+    if (den_size < limbs::DC_DIV_THRESHOLD || quotient_size < limbs::DC_DIV_THRESHOLD)
+    {
+        return divrem_basecase(quotient, num, num_size, den, den_size);
+    }
+    if (quotient_size < den_size)
+    {
+        return divrem_truncated(quotient, num, num_size, den, den_size);
+    }
+    if (quotient_size == den_size)
+    {
+        return divrem_dc_n(quotient, num, den, den_size);
+    }
+
+    const size_t first = quotient_size % den_size == 0 ? den_size : quotient_size % den_size;
+    size_t offset = quotient_size - first;
+    const bool high = div_qr(quotient + offset, num + offset, den_size + first, den, den_size);
+    while (offset > 0)
+    {
+        offset -= den_size;
+        divrem_dc_n(quotient + offset, num + offset, den, den_size);
+    }
+    return high;
+}
+
+// Divides 2n-limb blocks below den * B^n with two multiplications by the precomputed reciprocal floor(B^2n / den)
+// (Barrett, HAC 14.42): the estimate is never above the true quotient and at most two below it.
+class BarrettDivisor final
+{
+public:
+    BarrettDivisor(const uint64_t* den, const size_t size)
+        : _den(den), _size(size), _reciprocal(size + 1, 0), _product(2 * size + 2, 0), _estimate(size + 1, 0)
+    {
+        limbs::reciprocal(_reciprocal.data(), den, size);
+        if (size >= limbs::NTT_THRESHOLD)
+        {
+            limbs::ntt_forward(_reciprocal_transform, _reciprocal.data(), size + 1, limbs::ntt_length(2 * size + 2));
+            limbs::ntt_forward(_den_transform, den, size, limbs::ntt_length(2 * size));
+        }
+    }
+
+public:
+    void divide_block(uint64_t* quotient, uint64_t* num)
+    {
+        const size_t size = _size;
+        multiply_reciprocal(num + size - 1);
+        std::memcpy(_estimate.data(), _product.data() + size + 1, size * sizeof(uint64_t));
+
+        multiply_den(_estimate.data());
+        big_int_sub(num, 2 * size, _product.data(), 2 * size);
+        while (num[size] != 0 || limbs::cmp(num, _den, size) >= 0)
+        {
+            num[size] -= big_int_sub(num, size, _den, size);
+            limbs::add_limb(_estimate.data(), size, 1);
+        }
+
+        std::memcpy(quotient, _estimate.data(), size * sizeof(uint64_t));
+    }
+
+private:
+    void multiply_reciprocal(const uint64_t* top)
+    {
+        if (_reciprocal_transform.length != 0)
+        {
+            limbs::ntt_mul(_product.data(), _reciprocal_transform, top, _size + 1);
+        }
+        else
+        {
+            limbs::mul(_product.data(), top, _size + 1, _reciprocal.data(), _size + 1);
+        }
+    }
+
+    void multiply_den(const uint64_t* estimate)
+    {
+        if (_den_transform.length != 0)
+        {
+            limbs::ntt_mul(_product.data(), _den_transform, estimate, _size);
+        }
+        else
+        {
+            limbs::mul(_product.data(), estimate, _size, _den, _size);
+        }
+    }
+
+private:
+    const uint64_t* _den;
+    size_t _size;
+    LimbVector _reciprocal;
+    LimbVector _product;
+    LimbVector _estimate;
+    limbs::NttTransform _reciprocal_transform;
+    limbs::NttTransform _den_transform;
+};
+
+// The numerator has a zero spare top limb, so every block window is below den * B^n.
+void divrem_newton(uint64_t* quotient, uint64_t* num, const size_t num_size, const uint64_t* den,
+                   const size_t den_size)
+{
+    const size_t quotient_size = num_size - den_size;
+    const size_t first = quotient_size % den_size;
+    size_t offset = quotient_size - first;
+    if (first != 0)
+    {
+        div_qr(quotient + offset, num + offset, den_size + first, den, den_size);
+    }
+
+    BarrettDivisor divisor(den, den_size);
+    while (offset > 0)
+    {
+        offset -= den_size;
+        divisor.divide_block(quotient + offset, num + offset);
+    }
+}
+} // namespace
+
+namespace limbs
+{
+uint64_t div_1(uint64_t* quotient, const uint64_t* num, const size_t size, const LimbDivisor& den)
+{
+    const uint32_t shift = den.shift;
+    if (shift == 0)
+    {
+        uint64_t remainder = 0;
+        for (size_t i = size; i-- > 0;)
+        {
+            quotient[i] = div_2by1_preinv(remainder, num[i], den, remainder);
+        }
+        return remainder;
+    }
+
+    uint64_t remainder = num[size - 1] >> (64 - shift);
+    for (size_t i = size; i-- > 1;)
+    {
+        quotient[i] = div_2by1_preinv(remainder, (num[i] << shift) | (num[i - 1] >> (64 - shift)), den, remainder);
+    }
+    quotient[0] = div_2by1_preinv(remainder, num[0] << shift, den, remainder);
+    return remainder >> shift;
+}
+
+uint64_t div_1(uint64_t* quotient, const uint64_t* num, const size_t size, const uint64_t den)
+{
+    return div_1(quotient, num, size, LimbDivisor(den));
+}
+
+uint64_t mod_1(const uint64_t* num, const size_t size, const uint64_t den)
+{
+    const LimbDivisor divisor(den);
+    const uint32_t shift = divisor.shift;
+    uint64_t remainder = shift == 0 ? 0 : num[size - 1] >> (64 - shift);
+    for (size_t i = size; i-- > 0;)
+    {
+        const uint64_t low = shift == 0 ? num[i] : (num[i] << shift) | (i > 0 ? num[i - 1] >> (64 - shift) : 0);
+        div_2by1_preinv(remainder, low, divisor, remainder);
+    }
+    return remainder >> shift;
+}
+
+// Newton iteration on the reciprocal of the top half: with x = floor(B^2h / den_high), one step
+// x' = x * B^(n-h) + x * (B^(n+h) - den * x) / B^2h is within a few units of floor(B^2n / den), and a final
+// multiplication settles the last units.
+void reciprocal(uint64_t* res, const uint64_t* den, const size_t size)
+{
+    if (size < 2 * DC_DIV_THRESHOLD)
+    {
+        ScratchArena arena;
+        uint64_t* const num = arena.allocate(2 * size + 1);
+        std::memset(num, 0, 2 * size * sizeof(uint64_t));
+        num[2 * size] = 1;
+        if (size == 1)
+        {
+            uint64_t quotient[3];
+            div_1(quotient, num, 3, den[0]);
+            res[0] = quotient[0];
+            res[1] = quotient[1];
+        }
+        else
+        {
+            div_qr(res, num, 2 * size + 1, den, size);
+        }
+        return;
+    }
+
+    const size_t high = (size + 1) / 2;
+    const size_t low = size - high;
+    ScratchArena arena;
+    uint64_t* const high_reciprocal = arena.allocate(high + 1);
+    reciprocal(high_reciprocal, den + low, high);
+
+    uint64_t* const product = arena.allocate(size + high + 1);
+    mul(product, den, size, high_reciprocal, high + 1);
+    const bool negative = product[size + high] != 0;
+    if (negative)
+    {
+        --product[size + high];
+    }
+    else
+    {
+        negate(product, size + high);
+    }
+
+    uint64_t* const correction = arena.allocate(size + high + 2);
+    mul(correction, high_reciprocal, high + 1, product, size + 1);
+
+    std::memset(res, 0, low * sizeof(uint64_t));
+    std::memcpy(res + low, high_reciprocal, (high + 1) * sizeof(uint64_t));
+    const uint64_t* const delta = correction + 2 * high;
+    const size_t delta_size = size - high + 2;
+    if (negative)
+    {
+        big_int_sub(res, size + 1, delta, delta_size);
+    }
+    else
+    {
+        big_int_add(res, size + 1, delta, delta_size);
+    }
+
+    uint64_t* const remainder = arena.allocate(2 * size + 1);
+    mul(remainder, den, size, res, size + 1);
+    negate(remainder, 2 * size + 1);
+    ++remainder[2 * size];
+    while ((remainder[2 * size] >> 63) != 0)
+    {
+        sub_limb(res, size + 1, 1);
+        big_int_add(remainder, 2 * size + 1, den, size);
+    }
+    while (std::any_of(remainder + size, remainder + 2 * size + 1, [](const uint64_t limb) { return limb != 0; }) ||
+           cmp(remainder, den, size) >= 0)
+    {
+        add_limb(res, size + 1, 1);
+        big_int_sub(remainder, 2 * size + 1, den, size);
+    }
+}
+
+void divrem(uint64_t* quotient, uint64_t* remainder, const uint64_t* num, const size_t num_size, const uint64_t* den,
+            const size_t den_size)
+{
+    if (den_size == 1)
+    {
+        instrumentation::record_tier(instrumentation::Tier::DIV_LIMB);
+        remainder[0] = div_1(quotient, num, num_size, den[0]);
+        return;
+    }
+
+    const uint32_t shift = std::countl_zero(den[den_size - 1]);
+    ScratchArena arena;
+    uint64_t* const normalized_num = arena.allocate(num_size + 1 + den_size);
+    uint64_t* const normalized_den = normalized_num + num_size + 1;
+
+    if (shift != 0)
+    {
+        lshift(normalized_den, den, den_size, shift);
+        normalized_num[num_size] = lshift(normalized_num, num, num_size, shift);
+    }
+    else
+    {
+        std::memcpy(normalized_den, den, den_size * sizeof(uint64_t));
+        std::memcpy(normalized_num, num, num_size * sizeof(uint64_t));
+        normalized_num[num_size] = 0;
+    }
+
+    if (den_size >= NEWTON_DIV_THRESHOLD && num_size + 1 >= (NEWTON_DIV_MIN_BLOCKS + 1) * den_size)
+    {
+        instrumentation::record_tier(instrumentation::Tier::DIV_NEWTON);
+        divrem_newton(quotient, normalized_num, num_size + 1, normalized_den, den_size);
+    }
+    else
+    {
+        const size_t quotient_size = num_size + 1 - den_size;
+        instrumentation::record_tier(den_size < DC_DIV_THRESHOLD || quotient_size < DC_DIV_THRESHOLD
+                                         ? instrumentation::Tier::DIV_SCHOOLBOOK
+                                         : instrumentation::Tier::DIV_DIVIDE_AND_CONQUER);
+        div_qr(quotient, normalized_num, num_size + 1, normalized_den, den_size);
+    }
+
+    if (shift != 0)
+    {
+        rshift(remainder, normalized_num, den_size, shift);
+    }
+    else
+    {
+        std::memcpy(remainder, normalized_num, den_size * sizeof(uint64_t));
+    }
+}
+} // namespace limbs
@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include "limbs.hpp"
+
+extern "C"
+{
+    uint64_t big_int_mul_1_baseline(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_addmul_1_baseline(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_submul_1_baseline(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_redc_1_baseline(uint64_t* dest, uint64_t* product, const uint64_t* mod, size_t size,
+                                     uint64_t inverse);
+    uint64_t big_int_mul_1_mulx(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_addmul_1_mulx(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_submul_1_mulx(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_addmul_1_adx(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+    uint64_t big_int_redc_1_adx(uint64_t* dest, uint64_t* product, const uint64_t* mod, size_t size,
+                                uint64_t inverse);
+
+    // The exported kernels in big_int.s jump through these entries, so their order and offsets are fixed.
+    struct BigIntKernels
+    {
+        uint64_t (*mul_1)(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+        uint64_t (*addmul_1)(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+        uint64_t (*submul_1)(uint64_t* dest, const uint64_t* src, size_t size, uint64_t factor);
+        uint64_t (*redc_1)(uint64_t* dest, uint64_t* product, const uint64_t* mod, size_t size, uint64_t inverse);
+    };
+
+    // Starts on the baseline set so that the kernels are callable before the CPU is probed.
+    __attribute__((visibility("hidden"))) BigIntKernels big_int_kernels = {
+        big_int_mul_1_baseline, big_int_addmul_1_baseline, big_int_submul_1_baseline, big_int_redc_1_baseline};
+}
+
+namespace
+{
+static_assert(offsetof(BigIntKernels, addmul_1) == 8 && offsetof(BigIntKernels, submul_1) == 16 &&
+              offsetof(BigIntKernels, redc_1) == 24);
+
+limbs::Kernel active = limbs::Kernel::BASELINE;
+
+limbs::Kernel best_kernel()
+{
+    if (limbs::kernel_supported(limbs::Kernel::ADX))
+    {
+        return limbs::Kernel::ADX;
+    }
+    return limbs::kernel_supported(limbs::Kernel::MULX) ? limbs::Kernel::MULX : limbs::Kernel::BASELINE;
+}
+
+#ifdef BIGINT_FORCE_KERNEL
+constexpr limbs::Kernel forced_kernel()
+{
+    constexpr std::string_view name = BIGINT_FORCE_KERNEL;
+    static_assert(name == "baseline" || name == "mulx" || name == "adx",
+                  "BIGINT_FORCE_KERNEL must be baseline, mulx or adx");
+    return name == "adx" ? limbs::Kernel::ADX : name == "mulx" ? limbs::Kernel::MULX : limbs::Kernel::BASELINE;
+}
+#endif
+
+// Runs ahead of ordinary static initializers so that they already get the selected kernel. A forced kernel the CPU
+// lacks would fault on its first instruction, so it falls back to detection instead.
+__attribute__((constructor(101))) void select_kernel()
+{
+    __builtin_cpu_init();
+#ifdef BIGINT_FORCE_KERNEL
+    if (limbs::kernel_supported(forced_kernel()))
+    {
+        limbs::set_kernel(forced_kernel());
+        return;
+    }
+#endif
+    limbs::set_kernel(best_kernel());
+}
+} // namespace
+
+namespace limbs
+{
+Kernel kernel()
+{
+    return active;
+}
+
+bool kernel_supported(const Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::BASELINE:
+        return true;
+    case Kernel::MULX:
+        return __builtin_cpu_supports("bmi2");
+    case Kernel::ADX:
+        return __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx");
+    }
+    return false;
+}
+
+void set_kernel(const Kernel kernel)
+{
+    if (!kernel_supported(kernel))
+    {
+        throw std::invalid_argument("Kernel is not supported by this CPU");
+    }
+
+    switch (kernel)
+    {
+    case Kernel::BASELINE:
+        big_int_kernels = {big_int_mul_1_baseline, big_int_addmul_1_baseline, big_int_submul_1_baseline,
+                           big_int_redc_1_baseline};
+        break;
+    case Kernel::MULX:
+        big_int_kernels = {big_int_mul_1_mulx, big_int_addmul_1_mulx, big_int_submul_1_mulx, big_int_redc_1_baseline};
+        break;
+    case Kernel::ADX:
+        big_int_kernels = {big_int_mul_1_mulx, big_int_addmul_1_adx, big_int_submul_1_mulx, big_int_redc_1_adx};
+        break;
+    }
+    active = kernel;
+}
+
+const char* kernel_name(const Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::BASELINE:
+        return "baseline";
+    case Kernel::MULX:
+        return "mulx";
+    case Kernel::ADX:
+        return "adx";
+    }
+    return "unknown";
+}
+} // namespace limbs
@@ -0,0 +1,526 @@
+#include "limbs.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "Instrumentation.hpp"
+#include "big_int.h"
+
+namespace
+{
+using Point = std::array<int64_t, 2>;
+
+template <size_t K>
+struct ToomPlan final
+{
+    static constexpr size_t POINTS = 2 * K - 1;
+
+    std::array<std::array<int64_t, K>, POINTS> evaluation{};
+    std::array<std::array<int64_t, POINTS>, POINTS> interpolation{};
+    std::array<uint64_t, POINTS> odd_divisor{};
+    std::array<uint32_t, POINTS> shift{};
+};
+
+struct Fraction final
+{
+    __int128 num = 0;
+    __int128 den = 1;
+};
+
+constexpr __int128 abs128(const __int128 value)
+{
+    return value < 0 ? -value : value;
+}
+
+constexpr __int128 gcd128(__int128 a, __int128 b)
+{
+    a = abs128(a);
+    b = abs128(b);
+    while (b != 0)
+    {
+        a = std::exchange(b, a % b);
+    }
+    return a;
+}
+
+constexpr Fraction make_fraction(__int128 num, __int128 den)
+{
+    if (den < 0)
+    {
+        num = -num;
+        den = -den;
+    }
+    const __int128 divisor = gcd128(num, den);
+    return divisor > 1 ? Fraction{num / divisor, den / divisor} : Fraction{num, den};
+}
+
+constexpr Fraction operator-(const Fraction& lhs, const Fraction& rhs)
+{
+    return make_fraction(lhs.num * rhs.den - rhs.num * lhs.den, lhs.den * rhs.den);
+}
+
+constexpr Fraction operator*(const Fraction& lhs, const Fraction& rhs)
+{
+    return make_fraction(lhs.num * rhs.num, lhs.den * rhs.den);
+}
+
+constexpr Fraction operator/(const Fraction& lhs, const Fraction& rhs)
+{
+    return make_fraction(lhs.num * rhs.den, lhs.den * rhs.num);
+}
+
+constexpr int64_t power(const int64_t base, const size_t exponent)
+{
+    int64_t res = 1;
+    for (size_t i = 0; i < exponent; ++i)
+    {
+        res *= base;
+    }
+    return res;
+}
+
+// Evaluating at p/q homogeneously (multiplied by q^degree) keeps every point integral, infinity being (1, 0).
+// The interpolation rows are the inverse Vandermonde matrix scaled to a common denominator per coefficient.
+template <size_t K>
+constexpr ToomPlan<K> make_toom_plan(const std::array<Point, 2 * K - 1>& points)
+{
+    constexpr size_t N = 2 * K - 1;
+    ToomPlan<K> plan;
+
+    for (size_t j = 0; j < N; ++j)
+    {
+        for (size_t i = 0; i < K; ++i)
+        {
+            plan.evaluation[j][i] = power(points[j][0], i) * power(points[j][1], K - 1 - i);
+        }
+    }
+
+    std::array<std::array<Fraction, 2 * N>, N> matrix{};
+    for (size_t j = 0; j < N; ++j)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            matrix[j][i] = {power(points[j][0], i) * power(points[j][1], N - 1 - i), 1};
+        }
+        matrix[j][N + j] = {1, 1};
+    }
+
+    for (size_t col = 0; col < N; ++col)
+    {
+        size_t pivot = col;
+        while (matrix[pivot][col].num == 0)
+        {
+            ++pivot;
+        }
+        std::swap(matrix[pivot], matrix[col]);
+
+        const Fraction pivot_value = matrix[col][col];
+        for (Fraction& value : matrix[col])
+        {
+            value = value / pivot_value;
+        }
+
+        for (size_t row = 0; row < N; ++row)
+        {
+            const Fraction factor = matrix[row][col];
+            if (row == col || factor.num == 0)
+            {
+                continue;
+            }
+            for (size_t i = 0; i < 2 * N; ++i)
+            {
+                matrix[row][i] = matrix[row][i] - factor * matrix[col][i];
+            }
+        }
+    }
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        __int128 denominator = 1;
+        for (size_t j = 0; j < N; ++j)
+        {
+            const __int128 den = matrix[i][N + j].den;
+            denominator = denominator / gcd128(denominator, den) * den;
+        }
+        for (size_t j = 0; j < N; ++j)
+        {
+            const Fraction& value = matrix[i][N + j];
+            plan.interpolation[i][j] = static_cast<int64_t>(value.num * (denominator / value.den));
+        }
+        while (denominator % 2 == 0)
+        {
+            denominator /= 2;
+            ++plan.shift[i];
+        }
+        plan.odd_divisor[i] = static_cast<uint64_t>(denominator);
+    }
+
+    return plan;
+}
+
+constexpr ToomPlan<3> TOOM3_PLAN = make_toom_plan<3>({{{0, 1}, {1, 1}, {-1, 1}, {2, 1}, {1, 0}}});
+constexpr ToomPlan<4> TOOM4_PLAN = make_toom_plan<4>({{{0, 1}, {1, 1}, {-1, 1}, {2, 1}, {-2, 1}, {1, 2}, {1, 0}}});
+
+void add_into(uint64_t* dest, const size_t dest_size, const uint64_t* addend, size_t addend_size)
+{
+    addend_size = std::min(addend_size, dest_size);
+    while (addend_size > 0 && addend[addend_size - 1] == 0)
+    {
+        --addend_size;
+    }
+    if (addend_size > 0)
+    {
+        big_int_add(dest, dest_size, addend, addend_size);
+    }
+}
+
+void mul_basecase(uint64_t* res, const uint64_t* a, const size_t a_size, const uint64_t* b, const size_t b_size)
+{
+    res[a_size] = big_int_mul_1(res, a, a_size, b[0]);
+    for (size_t i = 1; i < b_size; ++i)
+    {
+        res[a_size + i] = big_int_addmul_1(res + i, a, a_size, b[i]);
+    }
+}
+
+// Each cross product a[i] a[j], i < j, once, then doubled by a shift and completed with the squares a[i]^2.
+void sqr_basecase(uint64_t* res, const uint64_t* a, const size_t size)
+{
+    res[0] = 0;
+    res[2 * size - 1] = 0;
+    if (size > 1)
+    {
+        res[size] = big_int_mul_1(res + 1, a + 1, size - 1, a[0]);
+        for (size_t i = 1; i + 1 < size; ++i)
+        {
+            res[size + i] = big_int_addmul_1(res + 2 * i + 1, a + i + 1, size - i - 1, a[i]);
+        }
+        limbs::lshift(res, res, 2 * size, 1);
+    }
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const __uint128_t square = static_cast<__uint128_t>(a[i]) * a[i];
+        const __uint128_t low = static_cast<__uint128_t>(res[2 * i]) + static_cast<uint64_t>(square) + carry;
+        const __uint128_t high =
+            static_cast<__uint128_t>(res[2 * i + 1]) + static_cast<uint64_t>(square >> 64) + (low >> 64);
+        res[2 * i] = static_cast<uint64_t>(low);
+        res[2 * i + 1] = static_cast<uint64_t>(high);
+        carry = static_cast<uint64_t>(high >> 64);
+    }
+}
+
+void mul_unbalanced(uint64_t* res, const uint64_t* a, const size_t a_size, const uint64_t* b, const size_t b_size)
+{
+    limbs::mul(res, a, b_size, b, b_size);
+    std::memset(res + 2 * b_size, 0, (a_size - b_size) * sizeof(uint64_t));
+
+    limbs::ScratchArena arena;
+    uint64_t* const product = arena.allocate(2 * b_size);
+    for (size_t offset = b_size; offset < a_size; offset += b_size)
+    {
+        const size_t chunk = std::min(b_size, a_size - offset);
+        limbs::mul(product, a + offset, chunk, b, b_size);
+        add_into(res + offset, a_size + b_size - offset, product, chunk + b_size);
+    }
+}
+
+void mul_karatsuba(uint64_t* res, const uint64_t* a, const size_t a_size, const uint64_t* b, const size_t b_size)
+{
+    const size_t half = (a_size + 1) / 2;
+    const size_t res_size = a_size + b_size;
+
+    limbs::ScratchArena arena;
+    uint64_t* const a_sum = arena.allocate(4 * half + 4);
+    uint64_t* const b_sum = a_sum + half + 1;
+    uint64_t* const middle = b_sum + half + 1;
+
+    std::memcpy(a_sum, a, half * sizeof(uint64_t));
+    std::memcpy(b_sum, b, half * sizeof(uint64_t));
+    a_sum[half] = big_int_add(a_sum, half, a + half, a_size - half);
+    b_sum[half] = big_int_add(b_sum, half, b + half, b_size - half);
+
+    limbs::parallel_for(3, a_size,
+                        [&](const size_t index)
+                        {
+                            switch (index)
+                            {
+                            case 0:
+                                limbs::mul(res, a, half, b, half);
+                                break;
+                            case 1:
+                                limbs::mul(res + 2 * half, a + half, a_size - half, b + half, b_size - half);
+                                break;
+                            default:
+                                limbs::mul(middle, a_sum, half + 1, b_sum, half + 1);
+                                break;
+                            }
+                        });
+
+    big_int_sub(middle, 2 * half + 2, res, 2 * half);
+    big_int_sub(middle, 2 * half + 2, res + 2 * half, res_size - 2 * half);
+    add_into(res + half, res_size - half, middle, 2 * half + 2);
+}
+
+void sqr_karatsuba(uint64_t* res, const uint64_t* a, const size_t size)
+{
+    const size_t half = (size + 1) / 2;
+    const size_t res_size = 2 * size;
+
+    limbs::ScratchArena arena;
+    uint64_t* const sum = arena.allocate(3 * half + 3);
+    uint64_t* const middle = sum + half + 1;
+
+    std::memcpy(sum, a, half * sizeof(uint64_t));
+    sum[half] = big_int_add(sum, half, a + half, size - half);
+
+    limbs::parallel_for(3, size,
+                        [&](const size_t index)
+                        {
+                            switch (index)
+                            {
+                            case 0:
+                                limbs::sqr(res, a, half);
+                                break;
+                            case 1:
+                                limbs::sqr(res + 2 * half, a + half, size - half);
+                                break;
+                            default:
+                                limbs::sqr(middle, sum, half + 1);
+                                break;
+                            }
+                        });
+
+    big_int_sub(middle, 2 * half + 2, res, 2 * half);
+    big_int_sub(middle, 2 * half + 2, res + 2 * half, res_size - 2 * half);
+    add_into(res + half, res_size - half, middle, 2 * half + 2);
+}
+
+template <size_t K>
+void evaluate(uint64_t* dest, const size_t part_size, const uint64_t* x, const size_t x_size,
+              const std::array<int64_t, K>& coefficients)
+{
+    std::memset(dest, 0, (part_size + 1) * sizeof(uint64_t));
+    for (size_t i = 0; i < K; ++i)
+    {
+        const size_t offset = i * part_size;
+        const size_t length = offset < x_size ? std::min(part_size, x_size - offset) : 0;
+        const int64_t coefficient = coefficients[i];
+        if (length == 0 || coefficient == 0)
+        {
+            continue;
+        }
+
+        if (coefficient > 0)
+        {
+            const uint64_t carry = big_int_addmul_1(dest, x + offset, length, coefficient);
+            limbs::add_limb(dest + length, part_size + 1 - length, carry);
+        }
+        else
+        {
+            const uint64_t borrow = big_int_submul_1(dest, x + offset, length, -coefficient);
+            limbs::sub_limb(dest + length, part_size + 1 - length, borrow);
+        }
+    }
+}
+
+bool make_magnitude(uint64_t* value, const size_t size)
+{
+    const bool negative = (value[size - 1] >> 63) != 0;
+    if (negative)
+    {
+        limbs::negate(value, size);
+    }
+    return negative;
+}
+
+template <size_t K>
+void mul_toom(uint64_t* res, const uint64_t* a, const size_t a_size, const uint64_t* b, const size_t b_size,
+              const ToomPlan<K>& plan)
+{
+    constexpr size_t POINTS = ToomPlan<K>::POINTS;
+    const size_t part_size = (a_size + K - 1) / K;
+    const size_t eval_size = part_size + 1;
+    const size_t product_size = 2 * eval_size;
+    const size_t res_size = a_size + b_size;
+
+    limbs::ScratchArena arena;
+    uint64_t* const a_evals = arena.allocate(2 * POINTS * eval_size + (POINTS + 1) * product_size);
+    uint64_t* const b_evals = a_evals + POINTS * eval_size;
+    uint64_t* const products = b_evals + POINTS * eval_size;
+    uint64_t* const acc = products + POINTS * product_size;
+
+    // Every point is evaluated up front so that the pointwise products are independent. A square evaluates its
+    // operand once and squares every point, which stays non-negative.
+    const bool square = a == b && a_size == b_size;
+    std::array<bool, POINTS> negative{};
+    for (size_t j = 0; j < POINTS; ++j)
+    {
+        uint64_t* const a_eval = a_evals + j * eval_size;
+        evaluate<K>(a_eval, part_size, a, a_size, plan.evaluation[j]);
+        negative[j] = make_magnitude(a_eval, eval_size);
+        if (!square)
+        {
+            uint64_t* const b_eval = b_evals + j * eval_size;
+            evaluate<K>(b_eval, part_size, b, b_size, plan.evaluation[j]);
+            negative[j] = negative[j] != make_magnitude(b_eval, eval_size);
+        }
+    }
+
+    limbs::parallel_for(POINTS, a_size,
+                        [&](const size_t j)
+                        {
+                            uint64_t* const product = products + j * product_size;
+                            if (square)
+                            {
+                                limbs::sqr(product, a_evals + j * eval_size, eval_size);
+                                return;
+                            }
+
+                            limbs::mul(product, a_evals + j * eval_size, eval_size, b_evals + j * eval_size, eval_size);
+                            if (negative[j])
+                            {
+                                limbs::negate(product, product_size);
+                            }
+                        });
+
+    std::memset(res, 0, res_size * sizeof(uint64_t));
+    for (size_t i = 0; i < POINTS && i * part_size < res_size; ++i)
+    {
+        std::memset(acc, 0, product_size * sizeof(uint64_t));
+        for (size_t j = 0; j < POINTS; ++j)
+        {
+            const int64_t coefficient = plan.interpolation[i][j];
+            if (coefficient > 0)
+            {
+                big_int_addmul_1(acc, products + j * product_size, product_size, coefficient);
+            }
+            else if (coefficient < 0)
+            {
+                big_int_submul_1(acc, products + j * product_size, product_size, -coefficient);
+            }
+        }
+
+        if (plan.odd_divisor[i] != 1)
+        {
+            limbs::divexact_1(acc, product_size, plan.odd_divisor[i]);
+        }
+        if (plan.shift[i] != 0)
+        {
+            limbs::rshift(acc, acc, product_size, plan.shift[i]);
+        }
+
+        add_into(res + i * part_size, res_size - i * part_size, acc, product_size);
+    }
+}
+} // namespace
+
+namespace limbs
+{
+void mul(uint64_t* res, const uint64_t* a, size_t a_size, const uint64_t* b, size_t b_size)
+{
+    const size_t res_size = a_size + b_size;
+    while (a_size > 0 && a[a_size - 1] == 0)
+    {
+        --a_size;
+    }
+    while (b_size > 0 && b[b_size - 1] == 0)
+    {
+        --b_size;
+    }
+
+    if (a_size == 0 || b_size == 0)
+    {
+        std::memset(res, 0, res_size * sizeof(uint64_t));
+        return;
+    }
+
+    if (a == b && a_size == b_size)
+    {
+        std::memset(res + 2 * a_size, 0, (res_size - 2 * a_size) * sizeof(uint64_t));
+        sqr(res, a, a_size);
+        return;
+    }
+
+    if (a_size < b_size)
+    {
+        std::swap(a, b);
+        std::swap(a_size, b_size);
+    }
+    std::memset(res + a_size + b_size, 0, (res_size - a_size - b_size) * sizeof(uint64_t));
+
+    if (b_size < KARATSUBA_THRESHOLD)
+    {
+        instrumentation::record_tier(instrumentation::Tier::MUL_BASECASE);
+        mul_basecase(res, a, a_size, b, b_size);
+    }
+    else if (b_size >= NTT_THRESHOLD)
+    {
+        instrumentation::record_tier(instrumentation::Tier::MUL_NTT);
+        mul_ntt(res, a, a_size, b, b_size);
+    }
+    else if (b_size <= (a_size + 1) / 2)
+    {
+        instrumentation::record_tier(instrumentation::Tier::MUL_UNBALANCED);
+        mul_unbalanced(res, a, a_size, b, b_size);
+    }
+    else if (b_size >= TOOM4_THRESHOLD)
+    {
+        instrumentation::record_tier(instrumentation::Tier::MUL_TOOM4);
+        mul_toom<4>(res, a, a_size, b, b_size, TOOM4_PLAN);
+    }
+    else if (b_size >= TOOM3_THRESHOLD)
+    {
+        instrumentation::record_tier(instrumentation::Tier::MUL_TOOM3);
+        mul_toom<3>(res, a, a_size, b, b_size, TOOM3_PLAN);
+    }
+    else
+    {
+        instrumentation::record_tier(instrumentation::Tier::MUL_KARATSUBA);
+        mul_karatsuba(res, a, a_size, b, b_size);
+    }
+}
+
+void sqr(uint64_t* res, const uint64_t* a, size_t size)
+{
+    const size_t res_size = 2 * size;
+    while (size > 0 && a[size - 1] == 0)
+    {
+        --size;
+    }
+    std::memset(res + 2 * size, 0, (res_size - 2 * size) * sizeof(uint64_t));
+
+    if (size == 0)
+    {
+        return;
+    }
+    if (size < SQR_KARATSUBA_THRESHOLD)
+    {
+        instrumentation::record_tier(instrumentation::Tier::SQR_BASECASE);
+        sqr_basecase(res, a, size);
+    }
+    else if (size >= SQR_NTT_THRESHOLD)
+    {
+        instrumentation::record_tier(instrumentation::Tier::SQR_NTT);
+        sqr_ntt(res, a, size);
+    }
+    else if (size >= SQR_TOOM4_THRESHOLD)
+    {
+        instrumentation::record_tier(instrumentation::Tier::SQR_TOOM4);
+        mul_toom<4>(res, a, size, a, size, TOOM4_PLAN);
+    }
+    else if (size >= SQR_TOOM3_THRESHOLD)
+    {
+        instrumentation::record_tier(instrumentation::Tier::SQR_TOOM3);
+        mul_toom<3>(res, a, size, a, size, TOOM3_PLAN);
+    }
+    else
+    {
+        instrumentation::record_tier(instrumentation::Tier::SQR_KARATSUBA);
+        sqr_karatsuba(res, a, size);
+    }
+}
+} // namespace limbs
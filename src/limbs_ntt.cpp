@@ -0,0 +1,344 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "limbs.hpp"
+
+namespace
+{
+class NttPrime final
+{
+public:
+    constexpr NttPrime(const uint64_t modulus, const uint64_t generator, const uint32_t max_log_length)
+        : _modulus(modulus), _generator(generator), _max_log_length(max_log_length)
+    {
+        _neg_inverse = modulus;
+        for (int i = 0; i < 6; ++i)
+        {
+            _neg_inverse *= 2 - modulus * _neg_inverse;
+        }
+        _neg_inverse = -_neg_inverse;
+        _r1 = (0 - modulus) % modulus;
+        _r2 = static_cast<uint64_t>(static_cast<__uint128_t>(_r1) * _r1 % modulus);
+    }
+
+public:
+    constexpr uint64_t modulus() const { return _modulus; }
+    constexpr uint32_t max_log_length() const { return _max_log_length; }
+
+    constexpr uint64_t mul(const uint64_t a, const uint64_t b) const
+    {
+        const __uint128_t product = static_cast<__uint128_t>(a) * b;
+        const uint64_t factor = static_cast<uint64_t>(product) * _neg_inverse;
+        const uint64_t res = static_cast<uint64_t>((product + static_cast<__uint128_t>(factor) * _modulus) >> 64);
+        return res >= _modulus ? res - _modulus : res;
+    }
+
+    constexpr uint64_t add(const uint64_t a, const uint64_t b) const
+    {
+        const uint64_t res = a + b;
+        return res >= _modulus ? res - _modulus : res;
+    }
+
+    constexpr uint64_t sub(const uint64_t a, const uint64_t b) const { return a >= b ? a - b : a + _modulus - b; }
+
+    constexpr uint64_t reduce(const uint64_t a) const { return mul(a, _r1); }
+    constexpr uint64_t to_montgomery(const uint64_t a) const { return mul(a, _r2); }
+
+    constexpr uint64_t pow(const uint64_t base, uint64_t exponent) const
+    {
+        uint64_t res = _r1;
+        uint64_t square = base;
+        for (; exponent != 0; exponent >>= 1)
+        {
+            if ((exponent & 1) != 0)
+            {
+                res = mul(res, square);
+            }
+            square = mul(square, square);
+        }
+        return res;
+    }
+
+    constexpr uint64_t inverse(const uint64_t a) const { return pow(a, _modulus - 2); }
+
+    constexpr uint64_t root(const size_t length) const
+    {
+        return pow(to_montgomery(_generator), (_modulus - 1) / length);
+    }
+
+private:
+    uint64_t _modulus;
+    uint64_t _generator;
+    uint32_t _max_log_length;
+    uint64_t _neg_inverse = 0;
+    uint64_t _r1 = 0;
+    uint64_t _r2 = 0;
+};
+
+constexpr size_t PRIMES_COUNT = 3;
+constexpr std::array<NttPrime, PRIMES_COUNT> PRIMES = {
+    NttPrime(0x3a00000000000001, 3, 57),
+    NttPrime(0x2c40000000000001, 7, 54),
+    NttPrime(0x28c0000000000001, 3, 54),
+};
+
+struct Twiddle final
+{
+    uint64_t value;
+    uint64_t quotient;
+};
+
+struct RootTable final
+{
+    std::vector<Twiddle> forward;
+    std::vector<Twiddle> inverse;
+};
+
+// Entry [half + j] of a table holds w^j for a primitive root w of order 2 * half, so one table serves every length
+// up to its own size. Twiddles are plain residues with their Shoup quotient floor(w * 2^64 / p).
+std::shared_ptr<const RootTable> root_table(const size_t prime_index, const size_t length)
+{
+    static std::mutex mutex;
+    static std::array<std::shared_ptr<const RootTable>, PRIMES_COUNT> tables;
+
+    const std::lock_guard lock(mutex);
+    std::shared_ptr<const RootTable>& cached = tables[prime_index];
+    if (cached && cached->forward.size() >= length)
+    {
+        return cached;
+    }
+
+    const NttPrime& prime = PRIMES[prime_index];
+    const auto make_twiddle = [&prime](const uint64_t montgomery_value)
+    {
+        const uint64_t value = prime.mul(montgomery_value, 1);
+        return Twiddle{value, static_cast<uint64_t>((static_cast<__uint128_t>(value) << 64) / prime.modulus())};
+    };
+
+    auto table = std::make_shared<RootTable>();
+    table->forward.resize(length);
+    table->inverse.resize(length);
+    for (size_t half = 1; half < length; half *= 2)
+    {
+        const uint64_t root = prime.root(2 * half);
+        const uint64_t inverse_root = prime.inverse(root);
+        uint64_t forward_power = prime.to_montgomery(1);
+        uint64_t inverse_power = forward_power;
+        for (size_t j = 0; j < half; ++j)
+        {
+            table->forward[half + j] = make_twiddle(forward_power);
+            table->inverse[half + j] = make_twiddle(inverse_power);
+            forward_power = prime.mul(forward_power, root);
+            inverse_power = prime.mul(inverse_power, inverse_root);
+        }
+    }
+
+    cached = std::move(table);
+    return cached;
+}
+
+// Returns x * w mod p in [0, 2p) for any 64-bit x.
+inline uint64_t mul_shoup(const uint64_t x, const Twiddle twiddle, const uint64_t modulus)
+{
+    const uint64_t quotient = static_cast<uint64_t>((static_cast<__uint128_t>(x) * twiddle.quotient) >> 64);
+    return x * twiddle.value - quotient * modulus;
+}
+
+// Both transforms keep values lazily reduced in [0, 2p), which leaves room for the butterflies since p < 2^62.
+void forward_transform(uint64_t* values, const size_t length, const uint64_t modulus, const Twiddle* roots)
+{
+    const uint64_t twice_modulus = 2 * modulus;
+    for (size_t half = length / 2; half >= 1; half /= 2)
+    {
+        for (size_t start = 0; start < length; start += 2 * half)
+        {
+            uint64_t* const low = values + start;
+            uint64_t* const high = low + half;
+            for (size_t j = 0; j < half; ++j)
+            {
+                const uint64_t u = low[j];
+                const uint64_t v = high[j];
+                const uint64_t sum = u + v;
+                low[j] = sum >= twice_modulus ? sum - twice_modulus : sum;
+                high[j] = mul_shoup(u - v + twice_modulus, roots[half + j], modulus);
+            }
+        }
+    }
+}
+
+void inverse_transform(uint64_t* values, const size_t length, const uint64_t modulus, const Twiddle* roots)
+{
+    const uint64_t twice_modulus = 2 * modulus;
+    for (size_t half = 1; half < length; half *= 2)
+    {
+        for (size_t start = 0; start < length; start += 2 * half)
+        {
+            uint64_t* const low = values + start;
+            uint64_t* const high = low + half;
+            for (size_t j = 0; j < half; ++j)
+            {
+                const uint64_t u = low[j];
+                const uint64_t v = mul_shoup(high[j], roots[half + j], modulus);
+                const uint64_t sum = u + v;
+                const uint64_t difference = u - v + twice_modulus;
+                low[j] = sum >= twice_modulus ? sum - twice_modulus : sum;
+                high[j] = difference >= twice_modulus ? difference - twice_modulus : difference;
+            }
+        }
+    }
+}
+
+void load(uint64_t* values, const size_t length, const NttPrime& prime, const uint64_t* a, const size_t a_size)
+{
+    for (size_t i = 0; i < a_size; ++i)
+    {
+        values[i] = prime.reduce(a[i]);
+    }
+    std::memset(values + a_size, 0, (length - a_size) * sizeof(uint64_t));
+}
+
+// The transforms keep values in the plain domain, so the pointwise Montgomery product leaves an extra R^-1. Every
+// Garner constant below folds that factor and the 1/length normalization in together.
+void recombine(uint64_t* res, const size_t res_size, const std::array<const uint64_t*, PRIMES_COUNT>& residues,
+               const size_t length)
+{
+    const NttPrime& p1 = PRIMES[0];
+    const NttPrime& p2 = PRIMES[1];
+    const NttPrime& p3 = PRIMES[2];
+
+    const uint64_t length_inverse1 = p1.inverse(p1.to_montgomery(length));
+    const uint64_t length_inverse2 = p2.inverse(p2.to_montgomery(length));
+    const uint64_t length_inverse3 = p3.inverse(p3.to_montgomery(length));
+    const uint64_t p1_inverse2 = p2.inverse(p2.to_montgomery(p1.modulus()));
+    const uint64_t p1_inverse3 = p3.inverse(p3.to_montgomery(p1.modulus()));
+    const uint64_t p2_inverse3 = p3.inverse(p3.to_montgomery(p2.modulus()));
+    const uint64_t p12_inverse3 = p3.mul(p1_inverse3, p2_inverse3);
+
+    const uint64_t scale1 = p1.to_montgomery(length_inverse1);
+    const uint64_t scale2 = p2.to_montgomery(p2.mul(length_inverse2, p1_inverse2));
+    const uint64_t scale3 = p3.to_montgomery(p3.mul(length_inverse3, p12_inverse3));
+
+    const __uint128_t p12 = static_cast<__uint128_t>(p1.modulus()) * p2.modulus();
+    const uint64_t p12_low = static_cast<uint64_t>(p12);
+    const uint64_t p12_high = static_cast<uint64_t>(p12 >> 64);
+
+    __uint128_t carry = 0;
+    for (size_t i = 0; i < res_size; ++i)
+    {
+        uint64_t x0 = 0;
+        __uint128_t x12 = 0;
+        if (i < length)
+        {
+            const uint64_t r1 = p1.mul(residues[0][i], scale1);
+            const uint64_t t2 = p2.sub(p2.mul(residues[1][i], scale2), p2.mul(r1, p1_inverse2));
+            const uint64_t t3 = p3.sub(p3.sub(p3.mul(residues[2][i], scale3), p3.mul(r1, p12_inverse3)),
+                                       p3.mul(t2, p2_inverse3));
+
+            const __uint128_t low = static_cast<__uint128_t>(p1.modulus()) * t2 + r1;
+            const __uint128_t high_low = static_cast<__uint128_t>(p12_low) * t3;
+            const __uint128_t sum0 = static_cast<__uint128_t>(static_cast<uint64_t>(low)) + static_cast<uint64_t>(high_low);
+            x0 = static_cast<uint64_t>(sum0);
+            x12 = static_cast<__uint128_t>(p12_high) * t3 + (high_low >> 64) + (low >> 64) + (sum0 >> 64);
+        }
+
+        const __uint128_t sum = static_cast<__uint128_t>(x0) + static_cast<uint64_t>(carry);
+        res[i] = static_cast<uint64_t>(sum);
+        carry = (carry >> 64) + x12 + (sum >> 64);
+    }
+}
+} // namespace
+
+namespace limbs
+{
+size_t ntt_length(const size_t res_size)
+{
+    const size_t length = std::bit_ceil(res_size);
+    if (std::countr_zero(length) > static_cast<int>(PRIMES[1].max_log_length()))
+    {
+        throw std::length_error("Operands are too large for the NTT multiplication");
+    }
+    return length;
+}
+
+void ntt_forward(NttTransform& transform, const uint64_t* a, const size_t a_size, const size_t length)
+{
+    transform.length = length;
+    transform.source_size = a_size;
+    transform.values.resize(PRIMES_COUNT * length);
+    parallel_for(PRIMES_COUNT, length,
+                 [&](const size_t k)
+                 {
+                     uint64_t* const values = transform.values.data() + k * length;
+                     load(values, length, PRIMES[k], a, a_size);
+                     forward_transform(values, length, PRIMES[k].modulus(), root_table(k, length)->forward.data());
+                 });
+}
+
+void ntt_mul(uint64_t* res, const NttTransform& a_transform, const uint64_t* b, const size_t b_size)
+{
+    const size_t length = a_transform.length;
+    const size_t res_size = a_transform.source_size + b_size;
+
+    ScratchArena arena;
+    uint64_t* const scratch = arena.allocate(PRIMES_COUNT * length);
+    std::array<const uint64_t*, PRIMES_COUNT> residues{};
+    parallel_for(PRIMES_COUNT, length,
+                 [&](const size_t k)
+                 {
+                     const NttPrime& prime = PRIMES[k];
+                     const std::shared_ptr<const RootTable> roots = root_table(k, length);
+                     const uint64_t* const a_values = a_transform.values.data() + k * length;
+                     uint64_t* const values = scratch + k * length;
+
+                     load(values, length, prime, b, b_size);
+                     forward_transform(values, length, prime.modulus(), roots->forward.data());
+                     for (size_t i = 0; i < length; ++i)
+                     {
+                         values[i] = prime.mul(values[i], a_values[i]);
+                     }
+                     inverse_transform(values, length, prime.modulus(), roots->inverse.data());
+                     residues[k] = values;
+                 });
+
+    recombine(res, res_size, residues, length);
+}
+
+void mul_ntt(uint64_t* res, const uint64_t* a, const size_t a_size, const uint64_t* b, const size_t b_size)
+{
+    NttTransform transform;
+    ntt_forward(transform, a, a_size, ntt_length(a_size + b_size));
+    ntt_mul(res, transform, b, b_size);
+}
+
+void sqr_ntt(uint64_t* res, const uint64_t* a, const size_t size)
+{
+    const size_t length = ntt_length(2 * size);
+    ScratchArena arena;
+    uint64_t* const scratch = arena.allocate(PRIMES_COUNT * length);
+    std::array<const uint64_t*, PRIMES_COUNT> residues{};
+    parallel_for(PRIMES_COUNT, length,
+                 [&](const size_t k)
+                 {
+                     const NttPrime& prime = PRIMES[k];
+                     const std::shared_ptr<const RootTable> roots = root_table(k, length);
+                     uint64_t* const values = scratch + k * length;
+
+                     load(values, length, prime, a, size);
+                     forward_transform(values, length, prime.modulus(), roots->forward.data());
+                     for (size_t i = 0; i < length; ++i)
+                     {
+                         values[i] = prime.mul(values[i], values[i]);
+                     }
+                     inverse_transform(values, length, prime.modulus(), roots->inverse.data());
+                     residues[k] = values;
+                 });
+
+    recombine(res, 2 * size, residues, length);
+}
+} // namespace limbs
@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "limbs.hpp"
+
+namespace
+{
+struct Job final
+{
+    void (*body)(void* context, size_t index);
+    void* context;
+    std::atomic<size_t> remaining;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    void run(const size_t index)
+    {
+        try
+        {
+            body(context, index);
+        }
+        catch (...)
+        {
+            const std::lock_guard lock(error_mutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+};
+
+struct Task final
+{
+    Job* job;
+    size_t index;
+};
+
+struct TaskQueue final
+{
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+class Scheduler;
+
+// The queue a thread pushes its forks to and pops first: its own for a worker, the shared injection queue otherwise.
+thread_local Scheduler* current_scheduler = nullptr;
+thread_local size_t current_queue = 0;
+
+// Every worker owns a deque: forks are pushed and popped at the back, idle workers steal from the front of the
+// others. Threads outside the pool share one extra queue.
+class Scheduler final
+{
+public:
+    explicit Scheduler(const size_t workers) : _queues(workers + 1)
+    {
+        _threads.reserve(workers);
+        for (size_t i = 0; i < workers; ++i)
+        {
+            _threads.emplace_back([this, i] { work(i); });
+        }
+    }
+
+public:
+    size_t idle_workers() const { return _idle.load(std::memory_order_relaxed); }
+
+    void submit(const Task& task)
+    {
+        TaskQueue& queue = _queues[home_queue()];
+        {
+            const std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(task);
+        }
+        _pending.fetch_add(1, std::memory_order_release);
+        {
+            const std::lock_guard lock(_sleep_mutex);
+        }
+        _wake.notify_one();
+    }
+
+    bool run_one()
+    {
+        const size_t home = home_queue();
+        Task task{};
+        if (!pop(_queues[home], true, task))
+        {
+            bool found = false;
+            for (size_t i = 1; i < _queues.size() && !found; ++i)
+            {
+                found = pop(_queues[(home + i) % _queues.size()], false, task);
+            }
+            if (!found)
+            {
+                return false;
+            }
+        }
+
+        Job* const job = task.job;
+        job->run(task.index);
+        job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+private:
+    size_t home_queue() const { return current_scheduler == this ? current_queue : _queues.size() - 1; }
+
+    bool pop(TaskQueue& queue, const bool own, Task& task)
+    {
+        const std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        if (own)
+        {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        _pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void work(const size_t index)
+    {
+        current_scheduler = this;
+        current_queue = index;
+        while (true)
+        {
+            if (run_one())
+            {
+                continue;
+            }
+
+            std::unique_lock lock(_sleep_mutex);
+            _idle.fetch_add(1, std::memory_order_relaxed);
+            _wake.wait(lock, [this] { return _stop || _pending.load(std::memory_order_acquire) > 0; });
+            _idle.fetch_sub(1, std::memory_order_relaxed);
+            if (_stop)
+            {
+                return;
+            }
+        }
+    }
+
+private:
+    std::vector<TaskQueue> _queues;
+    std::vector<std::thread> _threads;
+    std::atomic<size_t> _idle = 0;
+    std::atomic<size_t> _pending = 0;
+    std::mutex _sleep_mutex;
+    std::condition_variable _wake;
+    bool _stop = false;
+
+public:
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    Scheduler(Scheduler&&) = delete;
+    Scheduler& operator=(Scheduler&&) = delete;
+
+    ~Scheduler()
+    {
+        {
+            const std::lock_guard lock(_sleep_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (std::thread& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+};
+
+std::atomic<limbs::ExecutionPolicy::Mode> policy_mode = limbs::ExecutionPolicy::Mode::PARALLEL;
+std::atomic<size_t> policy_threads = 0;
+std::atomic<size_t> policy_min_limbs = limbs::PARALLEL_THRESHOLD;
+
+size_t thread_count()
+{
+    const size_t threads = policy_threads.load(std::memory_order_relaxed);
+    return threads != 0 ? threads : std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+std::mutex scheduler_mutex;
+std::unique_ptr<Scheduler> scheduler_instance;
+
+Scheduler& scheduler()
+{
+    const std::lock_guard lock(scheduler_mutex);
+    if (!scheduler_instance)
+    {
+        scheduler_instance = std::make_unique<Scheduler>(thread_count() - 1);
+    }
+    return *scheduler_instance;
+}
+} // namespace
+
+namespace limbs
+{
+ExecutionPolicy execution_policy()
+{
+    return {policy_mode.load(std::memory_order_relaxed), policy_threads.load(std::memory_order_relaxed),
+            policy_min_limbs.load(std::memory_order_relaxed)};
+}
+
+void set_execution_policy(const ExecutionPolicy& policy)
+{
+    const std::lock_guard lock(scheduler_mutex);
+    if (policy.threads != policy_threads.load(std::memory_order_relaxed))
+    {
+        scheduler_instance.reset();
+    }
+    policy_mode.store(policy.mode, std::memory_order_relaxed);
+    policy_threads.store(policy.threads, std::memory_order_relaxed);
+    policy_min_limbs.store(policy.min_limbs, std::memory_order_relaxed);
+}
+
+bool parallel_worthwhile(const size_t size)
+{
+    return policy_mode.load(std::memory_order_relaxed) == ExecutionPolicy::Mode::PARALLEL &&
+           size >= policy_min_limbs.load(std::memory_order_relaxed) && thread_count() > 1;
+}
+
+void parallel_for(const size_t count, void (*body)(void* context, size_t index), void* context)
+{
+    Scheduler& pool = scheduler();
+    const size_t forks = std::min(count - 1, pool.idle_workers());
+    Job job{body, context, forks, {}, {}};
+    for (size_t i = count - forks; i < count; ++i)
+    {
+        pool.submit({&job, i});
+    }
+    for (size_t i = 0; i < count - forks; ++i)
+    {
+        job.run(i);
+    }
+
+    // Whatever nobody stole is popped back and run here; otherwise help with other work until the job is done.
+    while (job.remaining.load(std::memory_order_acquire) != 0)
+    {
+        if (!pool.run_one())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (job.error)
+    {
+        std::rethrow_exception(job.error);
+    }
+}
+} // namespace limbs
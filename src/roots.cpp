@@ -0,0 +1,174 @@
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "BigUint.hpp"
+#include "limbs.hpp"
+
+namespace
+{
+using Uint128 = unsigned __int128;
+
+struct SquareFilter final
+{
+    uint64_t modulus;
+    uint64_t residues;
+};
+
+constexpr SquareFilter make_square_filter(const uint64_t modulus)
+{
+    uint64_t residues = 0;
+    for (uint64_t i = 0; i < modulus; ++i)
+    {
+        residues |= uint64_t{1} << (i * i % modulus);
+    }
+    return {modulus, residues};
+}
+
+// Pairwise coprime moduli whose product fits a limb, so one mod_1 pass serves every table. Together with the low six
+// bits, a non-square passes all of them with a probability below 1 / 10000.
+constexpr std::array<SquareFilter, 12> SQUARE_FILTERS = {
+    make_square_filter(63), make_square_filter(11), make_square_filter(17), make_square_filter(19),
+    make_square_filter(23), make_square_filter(29), make_square_filter(31), make_square_filter(37),
+    make_square_filter(41), make_square_filter(43), make_square_filter(47), make_square_filter(53)};
+constexpr SquareFilter SQUARE_FILTER_64 = make_square_filter(64);
+
+constexpr uint64_t filters_product()
+{
+    uint64_t product = 1;
+    for (const SquareFilter& filter : SQUARE_FILTERS)
+    {
+        product *= filter.modulus;
+    }
+    return product;
+}
+
+Uint128 isqrt128(const Uint128 value)
+{
+    constexpr Uint128 MAX_ROOT = UINT64_MAX;
+    const long double estimate = std::sqrt(static_cast<long double>(value));
+    Uint128 root = estimate >= static_cast<long double>(UINT64_MAX) ? MAX_ROOT : static_cast<uint64_t>(estimate);
+    while (root * root > value)
+    {
+        --root;
+    }
+    while (root < MAX_ROOT && (root + 1) * (root + 1) <= value)
+    {
+        ++root;
+    }
+    return root;
+}
+} // namespace
+
+// The root of the top half of the bits, shifted back, is below the root by less than 2^k; one Newton step from there
+// lands at most a couple of units above it. The recursion halves the size each time, so the total stays within a
+// small multiple of one division at full size.
+BigUint BigUint::isqrt() const
+{
+    if (_number.size() <= 2)
+    {
+        const Uint128 value = _number.size() == 1 ? _number[0] : (static_cast<Uint128>(_number[1]) << 64) | _number[0];
+        return BigUint(static_cast<uint64_t>(isqrt128(value)));
+    }
+
+    const size_t shift = bit_width() / 4;
+    BigUint root = (*this >> (2 * shift)).isqrt() << shift;
+    root += *this / root;
+    root >>= 1;
+
+    BigUint square = root.square();
+    while (square > *this)
+    {
+        square -= root;
+        root -= 1;
+        square -= root;
+    }
+    return root;
+}
+
+std::pair<BigUint, BigUint> BigUint::isqrt_rem() const
+{
+    BigUint root = isqrt();
+    BigUint remainder = *this - root.square();
+    return {std::move(root), std::move(remainder)};
+}
+
+// Newton's x' = ((k - 1) x + n / x^(k-1)) / k from the root of the top bits, as for isqrt. From any positive start the
+// first step lands at or above the root, and from there the iteration decreases until it stops at the root.
+BigUint BigUint::iroot(const uint64_t k) const
+{
+    if (k == 0)
+    {
+        throw std::invalid_argument("Root degree must be positive");
+    }
+    if (k == 1)
+    {
+        return *this;
+    }
+    if (k == 2)
+    {
+        return isqrt();
+    }
+    if (is_zero())
+    {
+        return 0;
+    }
+
+    const size_t bits = bit_width();
+    const size_t root_bits = (bits - 1) / k + 1;
+    if (root_bits <= 64)
+    {
+        uint64_t root = 0;
+        for (size_t bit = root_bits; bit-- > 0;)
+        {
+            const uint64_t candidate = root | (uint64_t{1} << bit);
+            if (BigUint(candidate).pow(k) <= *this)
+            {
+                root = candidate;
+            }
+        }
+        return root;
+    }
+
+    const auto newton_step = [&](const BigUint& x)
+    {
+        BigUint next = *this / x.pow(k - 1);
+        next += x * (k - 1);
+        next /= k;
+        return next;
+    };
+
+    const size_t guard_bits = std::bit_width(k) / 2 + 2;
+    const size_t shift = root_bits / 2 > guard_bits ? root_bits / 2 - guard_bits : 1;
+    BigUint root = newton_step((*this >> (k * shift)).iroot(k) << shift);
+    while (true)
+    {
+        BigUint next = newton_step(root);
+        if (next >= root)
+        {
+            return root;
+        }
+        root = std::move(next);
+    }
+}
+
+bool BigUint::is_perfect_square() const
+{
+    if (((SQUARE_FILTER_64.residues >> (_number[0] & 63)) & 1) == 0)
+    {
+        return false;
+    }
+
+    const uint64_t residue = limbs::mod_1(_number.data(), _number.size(), filters_product());
+    for (const SquareFilter& filter : SQUARE_FILTERS)
+    {
+        if (((filter.residues >> (residue % filter.modulus)) & 1) == 0)
+        {
+            return false;
+        }
+    }
+    return isqrt_rem().second.is_zero();
+}